@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class ByteClasses {
+public:
+    static constexpr size_t alphabetSize = 256;
+
+private:
+    std::array<uint8_t, alphabetSize> classMap{};
+    std::vector<unsigned char> representatives = {0};
+
+public:
+    ByteClasses() = default;
+    ByteClasses(std::span<const uint32_t> offsets, std::span<const char> symbols, std::span<const uint32_t> targets);
+
+    [[nodiscard]] uint8_t operator[](const unsigned char byte) const {
+        return classMap[byte];
+    }
+
+    [[nodiscard]] const uint8_t* data() const {
+        return classMap.data();
+    }
+
+    [[nodiscard]] size_t size() const {
+        return representatives.size();
+    }
+
+    [[nodiscard]] unsigned char representative(const size_t byteClass) const {
+        return representatives[byteClass];
+    }
+};
\ No newline at end of file
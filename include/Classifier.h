@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <CombinedNFA.h>
+
+// Lazily determinizes a CombinedNFA under a memory budget, the way LazyDFA does for a single NFA. Each cached
+// state carries the configurations it accepts, so one scan of a word classifies it against all of them.
+// Universal states are emitted on the transition that reaches them and never enter a subset, which keeps
+// "contains a match" rules from multiplying the number of cached states.
+// A Classifier mutates its cache while matching; concurrent scans each need their own instance.
+class Classifier {
+public:
+    static constexpr size_t defaultMemoryBudget = 32 << 20;
+    static constexpr size_t defaultFlushLimit = 4;
+
+    struct Counters {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t flushes = 0;
+        size_t fallbacks = 0;
+    };
+
+private:
+    static constexpr int32_t deadState = -1;
+    static constexpr int32_t unknownState = -2;
+
+    struct SubsetHash {
+        size_t operator()(const std::vector<uint32_t>& subset) const noexcept {
+            uint64_t h = 0xcbf29ce484222325;
+            for (const auto& state : subset) {
+                h = (h ^ state) * 0x100000001b3;
+            }
+            return h ^ (h >> 32);
+        }
+    };
+
+    const CombinedNFA& nfa;
+    size_t memoryBudget;
+    size_t flushLimit;
+    size_t cachedBytes = 0;
+
+    // A cached state is its subset plus the configurations emitted on entering it; the key joins both.
+    std::vector<std::vector<uint32_t>> subsets;
+    std::vector<std::vector<uint32_t>> emitted;
+    std::unordered_map<std::vector<uint32_t>, int32_t, SubsetHash> subsetIds;
+    std::vector<int32_t> table;
+    std::vector<std::vector<uint32_t>> accepted;
+    std::vector<uint32_t> scratch;
+    std::vector<uint32_t> scratchEmitted;
+    std::vector<uint32_t> key;
+    std::vector<uint8_t> marks;
+
+    std::vector<uint32_t> wordEmitted;
+    std::vector<uint32_t> none;
+    std::vector<uint32_t> fallbackAccepted;
+    std::vector<uint32_t> result;
+    Counters counters;
+
+    int32_t addState(const std::vector<uint32_t>& subset, const std::vector<uint32_t>& emits);
+    int32_t transition(int32_t state, uint8_t byteClass, size_t& flushes);
+    void flush();
+    void advance(const std::vector<uint32_t>& from, uint8_t byteClass, std::vector<uint32_t>& to);
+    void settle(std::vector<uint32_t>& subset, std::vector<uint32_t>& emits) const;
+    void makeKey(const std::vector<uint32_t>& subset, const std::vector<uint32_t>& emits);
+    void collectAccepted(const std::vector<uint32_t>& subset, std::vector<uint32_t>& configs) const;
+    const std::vector<uint32_t>& finish(std::string_view word, const std::vector<uint32_t>& configs);
+    const std::vector<uint32_t>& simulate(std::vector<uint32_t> current, std::string_view word, size_t position);
+
+public:
+    explicit Classifier(const CombinedNFA& nfa_, size_t memoryBudget_ = defaultMemoryBudget, size_t flushLimit_ = defaultFlushLimit);
+
+    // Indices into nfa.getConfigs() of every configuration that accepts `word`, in increasing order.
+    // The result stays valid until the next call.
+    const std::vector<uint32_t>& classify(std::string_view word);
+
+    [[nodiscard]] const Counters& getCounters() const;
+    [[nodiscard]] size_t getCachedStates() const;
+    void resetCounters();
+
+    ~Classifier() = default;
+};
\ No newline at end of file
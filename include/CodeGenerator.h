@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+#include <DFA.h>
+
+// Emits a DFA as a standalone C++ matcher: one goto label per state and a switch over the next byte,
+// with no transition tables left at runtime.
+class CodeGenerator {
+    static std::string caseLabel(unsigned char byte);
+
+public:
+    static std::string source(const DFA& dfa, const std::string& function, const std::string& origin);
+    static std::string header(const std::string& function, const std::string& origin);
+
+    static void write(const DFA& dfa, const std::string& function, const std::string& origin, const std::string& sourceFile, const std::string& headerFile);
+};
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <ByteClasses.h>
+#include <FiniteAutomaton.h>
+
+// The disjoint union of several configurations, each loaded with NFA semantics. Every state remembers the
+// configuration it came from, so a set of reached final states names the configurations that accept.
+// Successors are kept sparse, since the union of hundreds of configurations is too large for per-state bitsets.
+class CombinedNFA : public FiniteAutomaton {
+public:
+    using ClassMask = std::array<uint64_t, ByteClasses::alphabetSize / 64>;
+
+private:
+    std::vector<std::string> configs;
+    std::vector<uint32_t> owners;
+    std::vector<ClassMask> sigmaClasses;
+    ByteClasses classes;
+
+    // Epsilon-closed successors per state and class, laid out by computeSuccessors.
+    std::vector<uint32_t> successorOffsets = {0};
+    std::vector<uint32_t> successorTargets;
+    std::vector<uint32_t> initialStates;
+
+    // A universal state accepts every word over its configuration's Sigma, so reaching it decides that
+    // configuration for the rest of the word.
+    std::vector<uint8_t> universal;
+
+    friend class Classifier;
+
+    void compile(const std::vector<uint32_t>& starts);
+    void findUniversal(const std::vector<std::vector<char>>& sigmas);
+
+public:
+    explicit CombinedNFA(std::vector<std::string> configs_);
+
+    [[nodiscard]] const std::vector<std::string>& getConfigs() const;
+
+    ~CombinedNFA() = default;
+};
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <DFA.h>
+#include <MappedFile.h>
+#include <NFA.h>
+
+class CompiledAutomaton {
+public:
+    enum class Kind : uint32_t { DFA = 0, NFA = 1 };
+
+    static constexpr char magic[8] = {'D', 'F', 'A', 'N', 'F', 'A', 'B', 0};
+    static constexpr uint32_t version = 2;
+    static constexpr uint32_t byteOrder = 0x01020304;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        Kind kind;
+        uint32_t stateCount;
+        uint32_t classCount;
+        int32_t start;
+        uint64_t transitionCount;
+        uint64_t classMapOffset;
+        uint64_t transitionsOffset;
+        uint64_t targetsOffset;
+        uint64_t finalOffset;
+        uint64_t initialOffset;
+        uint64_t sigmaOffset;
+        uint64_t sigmaSize;
+        uint64_t nameOffsetsOffset;
+        uint64_t namesOffset;
+        uint64_t namesSize;
+    };
+
+private:
+    MappedFile file;
+    const Header* header = nullptr;
+    const uint8_t* classMap = nullptr;
+    const int32_t* table = nullptr;
+    const uint32_t* offsets = nullptr;
+    const uint32_t* targets = nullptr;
+    const uint64_t* finalStates = nullptr;
+    const uint64_t* initialStates = nullptr;
+    const uint32_t* nameOffsets = nullptr;
+    const char* names = nullptr;
+
+    template <typename T>
+    const T* section(uint64_t offset, uint64_t count) const;
+
+    void validate() const;
+    [[nodiscard]] bool isFinal(uint32_t state) const;
+    bool processDFA(std::string_view word) const;
+    bool processNFA(std::string_view word) const;
+
+public:
+    explicit CompiledAutomaton(const std::string& file_);
+
+    static void save(const DFA& dfa, const std::string& file);
+    static void save(const NFA& nfa, const std::string& file);
+
+    bool process(std::string_view word) const;
+
+    [[nodiscard]] Kind getKind() const;
+    [[nodiscard]] size_t getStateCount() const;
+    [[nodiscard]] std::string_view getSigma() const;
+    [[nodiscard]] std::string_view getStateName(uint32_t state) const;
+
+    ~CompiledAutomaton() = default;
+};
\ No newline at end of file
@@ -1,11 +1,92 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <ByteClasses.h>
 #include <FiniteAutomaton.h>
 
+class NFA;
+class ThreadPool;
+
 class DFA : public FiniteAutomaton {
+public:
+    enum class Mode { Graph, Table };
+
+    static constexpr int32_t deadState = -1;
+    static constexpr size_t defaultStateLimit = 1 << 20;
+    static constexpr size_t batchLanes = 8;
+    static constexpr size_t parallelThreshold = 1 << 20;
+    static constexpr size_t speculationLookback = 256;
+    static constexpr size_t convergenceWindow = 512;
+
+    struct BuildReport {
+        size_t sourceStates = 0;
+        size_t resultStates = 0;
+        std::chrono::microseconds buildTime{0};
+        // Filled in by minimize(): the state count it started from (0 if it never ran) and the time it took.
+        size_t unminimizedStates = 0;
+        std::chrono::microseconds minimizeTime{0};
+    };
+
+private:
+    Mode mode = Mode::Table;
+    ByteClasses classes;
+    std::vector<int32_t> table;
+    std::vector<uint8_t> finalStates;
+    int32_t start = deadState;
+    BuildReport report;
+
+    friend class CompiledAutomaton;
+    friend class CodeGenerator;
+
     void validate();
+    void compile();
+    void rebuild(const std::vector<int32_t>& representatives, const std::vector<int32_t>& classOf, int32_t startClass);
+
+    bool processGraph(std::string_view word) const;
+    bool processTable(std::string_view word) const;
+    void processLanes(std::span<const std::string_view> words, std::vector<bool>& results) const;
+    // What one speculatively run chunk tells the serial pass that stitches the chunks together.
+    struct Speculation {
+        std::vector<int32_t> candidates;
+        std::vector<int32_t> outcomes;
+        // The single live state after each 64-byte interval from `converged` on, for entry states that were not guessed.
+        std::vector<int32_t> trail;
+        size_t converged = 0;
+        bool abandoned = false;
+    };
+
+    static constexpr size_t mergeInterval = 64;
+
+    [[nodiscard]] Speculation speculate(std::string_view chunk, std::vector<int32_t> candidates) const;
+    [[nodiscard]] int32_t resume(int32_t state, std::string_view chunk, const Speculation& speculation) const;
+#if defined(__AVX2__)
+    void processGather(std::span<const std::string_view> words, std::vector<bool>& results) const;
+#endif
+
+    DFA() = default;
+
 public:
     explicit DFA(const std::string& file);
-    bool process(const std::string& word) const;
+    // Loads a configuration and applies the checks DFA(file) does, reporting through UserWarn, without building tables.
+    static void validateConfig(const std::string& file);
+    explicit DFA(const NFA& nfa, size_t stateLimit = defaultStateLimit);
+
+    void setMode(Mode mode_);
+    [[nodiscard]] Mode getMode() const;
+    [[nodiscard]] const BuildReport& getBuildReport() const;
+
+    void minimize();
+
+    bool process(std::string_view word) const;
+    [[nodiscard]] int32_t step(int32_t state, std::string_view chunk) const;
+    [[nodiscard]] int32_t getStart() const;
+    [[nodiscard]] bool isFinal(int32_t state) const;
+    [[nodiscard]] std::vector<bool> processBatch(std::span<const std::string_view> words) const;
+    bool processParallel(std::string_view input, ThreadPool& pool) const;
     ~DFA() = default;
 };
\ No newline at end of file
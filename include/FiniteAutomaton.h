@@ -1,26 +1,51 @@
 #pragma once
 
-#include <unordered_map>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
-#include <memory>
 
-#include <State.h>
+#include <ByteClasses.h>
+#include <Parser.h>
 
+// States are dense ids. The edges of state s are [edgeOffsets[s], edgeOffsets[s + 1]) in edgeSymbols and
+// edgeTargets, sorted by symbol; epsilon edges have their own offsets. Names sit in a side arena that
+// matching never reads.
 class FiniteAutomaton {
+public:
+    static constexpr uint32_t noState = UINT32_MAX;
+
 protected:
     std::unordered_set<char> sigma;
-    std::vector<std::shared_ptr<State>> states;
-    std::unordered_map<std::string, std::shared_ptr<State>> stateMap;
-    std::shared_ptr<State> startState = nullptr;
+    std::string names;
+    std::vector<uint32_t> nameOffsets = {0};
+    std::vector<uint8_t> finals;
+    uint32_t startState = noState;
 
-    bool inSigma(const char& symbol);
+    std::vector<uint32_t> edgeOffsets = {0};
+    std::vector<char> edgeSymbols;
+    std::vector<uint32_t> edgeTargets;
+    std::vector<uint32_t> epsilonOffsets = {0};
+    std::vector<uint32_t> epsilonTargets;
 
-    void setSigma(std::vector<std::string> const& sigma_);
-    void setStates(const std::vector<std::string>& stateLines);
-    void setTransitions(std::vector<std::string> const& transitions);
-    void setStartState();
+    void load(const Parser& parser);
+    // Adds the parser's states after the existing ones, queues their renumbered transitions and returns the start.
+    uint32_t append(const Parser& parser, std::vector<Parser::Transition>& transitions);
+    uint32_t addState(std::string_view name, bool final);
+    void setTransitions(std::span<const Parser::Transition> transitions);
+
+    // The closure of state s is closureTargets from closureOffsets[s] up to closureOffsets[s + 1], sorted.
+    void computeClosures(std::vector<uint32_t>& closureOffsets, std::vector<uint32_t>& closureTargets) const;
+    // Epsilon-closed successors of state s on class c, sorted, in successorTargets from successorOffsets[i]
+    // up to successorOffsets[i + 1], where i = s * classes.size() + c.
+    void computeSuccessors(const ByteClasses& classes, const std::vector<uint32_t>& closureOffsets, const std::vector<uint32_t>& closureTargets,
+                           std::vector<uint32_t>& successorOffsets, std::vector<uint32_t>& successorTargets) const;
 
 public:
+    [[nodiscard]] size_t getStateCount() const;
+    [[nodiscard]] std::string_view getStateName(size_t index) const;
+
     ~FiniteAutomaton() = default;
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Generator {
+public:
+    static constexpr std::string_view symbols = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+    struct Parameters {
+        size_t states = 16;
+        size_t alphabet = 2;
+        size_t outDegree = 2;
+        double nondeterminism = 1.0;
+        double finalDensity = 0.5;
+        uint64_t seed = 1;
+    };
+
+private:
+    Parameters parameters;
+    std::vector<uint32_t> offsets;
+    std::vector<char> edgeSymbols;
+    std::vector<uint32_t> targets;
+    std::vector<uint8_t> finalStates;
+    mutable std::mt19937_64 rng;
+    mutable std::vector<uint32_t> stamps;
+    mutable uint32_t stamp = 0;
+
+    [[nodiscard]] bool accepts(std::string_view word) const;
+    bool walk(size_t length, std::string& word) const;
+    bool scatter(size_t length, std::string& word) const;
+
+public:
+    explicit Generator(const Parameters& parameters_);
+
+    [[nodiscard]] size_t getTransitionCount() const;
+    [[nodiscard]] bool isDeterministic() const;
+
+    [[nodiscard]] std::vector<std::string> corpus(size_t count, size_t minLength, size_t maxLength, double acceptRatio) const;
+
+    void writeConfig(const std::string& file) const;
+    void writeCorpus(const std::string& file, size_t count, size_t minLength, size_t maxLength, double acceptRatio) const;
+
+    ~Generator() = default;
+};
\ No newline at end of file
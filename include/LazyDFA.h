@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <NFA.h>
+#include <StateSet.h>
+
+class LazyDFA {
+public:
+    static constexpr size_t defaultMemoryBudget = 8 << 20;
+    static constexpr size_t defaultFlushLimit = 4;
+
+    struct Counters {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t flushes = 0;
+        size_t fallbacks = 0;
+    };
+
+private:
+    static constexpr int32_t deadState = -1;
+    static constexpr int32_t unknownState = -2;
+
+    const NFA& nfa;
+    size_t memoryBudget;
+    size_t flushLimit;
+    size_t stateBytes;
+
+    std::vector<StateSet> subsets;
+    std::unordered_map<StateSet, int32_t> subsetIds;
+    std::vector<int32_t> table;
+    std::vector<uint8_t> finalStates;
+    StateSet scratch;
+    Counters counters;
+
+    int32_t addState(const StateSet& subset);
+    int32_t transition(int32_t state, uint8_t byteClass, size_t& flushes);
+    void flush();
+    bool simulate(const StateSet& from, std::string_view word, size_t position) const;
+
+public:
+    explicit LazyDFA(const NFA& nfa_, size_t memoryBudget_ = defaultMemoryBudget, size_t flushLimit_ = defaultFlushLimit);
+
+    bool process(std::string_view word);
+
+    [[nodiscard]] const Counters& getCounters() const;
+    [[nodiscard]] size_t getCachedStates() const;
+    void resetCounters();
+
+    ~LazyDFA() = default;
+};
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+class MappedFile {
+    const char* begin = nullptr;
+    size_t length = 0;
+#if defined(_WIN32)
+    void* mapping = nullptr;
+#endif
+
+    void release();
+
+public:
+    explicit MappedFile(const std::string& file);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    [[nodiscard]] const char* data() const;
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] std::string_view view() const;
+
+    ~MappedFile();
+};
\ No newline at end of file
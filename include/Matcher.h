@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string_view>
+
+#include <DFA.h>
+#include <NFA.h>
+#include <StateSet.h>
+
+template <typename FA>
+class Matcher;
+
+template <>
+class Matcher<DFA> {
+    const DFA& dfa;
+    int32_t state;
+
+public:
+    explicit Matcher(const DFA& dfa_) : dfa(dfa_), state(dfa_.getStart()) {}
+
+    void feed(const std::string_view chunk) {
+        if (state != DFA::deadState) {
+            state = dfa.step(state, chunk);
+        }
+    }
+
+    [[nodiscard]] bool isAccepting() const {
+        return state != DFA::deadState && dfa.isFinal(state);
+    }
+
+    void reset() {
+        state = dfa.getStart();
+    }
+};
+
+template <>
+class Matcher<NFA> {
+    const NFA& nfa;
+    StateSet current;
+    StateSet next;
+    bool alive;
+
+public:
+    explicit Matcher(const NFA& nfa_) : nfa(nfa_), current(nfa_.getInitialStates()), next(current.size()), alive(!current.empty()) {}
+
+    void feed(const std::string_view chunk) {
+        if (alive) {
+            alive = nfa.step(current, next, chunk);
+        }
+    }
+
+    [[nodiscard]] bool isAccepting() const {
+        return alive && nfa.accepts(current);
+    }
+
+    void reset() {
+        current = nfa.getInitialStates();
+        alive = !current.empty();
+    }
+};
\ No newline at end of file
@@ -1,10 +1,52 @@
 #pragma once
 
+#include <string_view>
+
+#include <ByteClasses.h>
 #include <FiniteAutomaton.h>
+#include <StateSet.h>
 
 class NFA : public FiniteAutomaton {
+public:
+    enum class Mode { Graph, Bitset };
+
+private:
+    Mode mode = Mode::Bitset;
+    ByteClasses classes;
+    // Epsilon-closed successors per state and class, laid out by computeSuccessors. Only the active sets are dense.
+    std::vector<uint32_t> successorOffsets = {0};
+    std::vector<uint32_t> successorTargets;
+    StateSet initialStates;
+    StateSet finalStates;
+
+    void compile();
+    void addSuccessors(const size_t state, const size_t byteClass, StateSet& next) const {
+        const size_t row = state * classes.size() + byteClass;
+        for (uint32_t i = successorOffsets[row]; i < successorOffsets[row + 1]; ++i) {
+            next.insert(successorTargets[i]);
+        }
+    }
+    void expandGraphClosure(std::vector<uint32_t>& currentStates) const;
+
+    friend class DFA;
+    friend class LazyDFA;
+    friend class CompiledAutomaton;
+    friend class Regex;
+
+    NFA() = default;
+
+    bool processGraph(std::string_view word) const;
+    bool processBitset(std::string_view word) const;
+
 public:
     explicit NFA(const std::string& file);
-    bool process(const std::string& word) const;
+
+    void setMode(Mode mode_);
+    [[nodiscard]] Mode getMode() const;
+
+    bool process(std::string_view word) const;
+    bool step(StateSet& current, StateSet& next, std::string_view chunk) const;
+    [[nodiscard]] const StateSet& getInitialStates() const;
+    [[nodiscard]] bool accepts(const StateSet& current) const;
     ~NFA() = default;
 };
\ No newline at end of file
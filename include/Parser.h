@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <MappedFile.h>
+
+class Parser {
+public:
+    static constexpr std::string_view epsilonSymbols[] = {"eps", "\xCE\xB5"};
+
+    struct Transition {
+        uint32_t from;
+        char symbol;
+        uint32_t to;
+        bool epsilon = false;
+    };
+
+private:
+    enum class Section { None, Sigma, States, Transitions };
+
+    // A tokenized transition line whose target name is hashed but not yet interned.
+    struct PendingTransition {
+        std::string_view line;
+        size_t lineNumber;
+        std::string_view from;
+        std::string_view symbol;
+        std::string_view to;
+        uint32_t toHash;
+    };
+
+    MappedFile file;
+    std::vector<char> sigma;
+    std::string arena;
+    std::vector<uint32_t> nameOffsets = {0};
+    std::vector<uint32_t> declarations;
+    std::vector<uint8_t> declared;
+    std::vector<uint8_t> initial;
+    std::vector<uint8_t> final;
+    std::vector<Transition> transitions;
+    bool hasInitialState = false;
+    std::vector<uint64_t> slots;
+    std::string_view lastFromName;
+    uint32_t lastFrom = 0;
+    std::array<PendingTransition, 32> pending;
+    size_t pendingCount = 0;
+
+    template <typename Visitor>
+    static void forEachLine(std::string_view text, Visitor&& visit);
+    static uint32_t hash(std::string_view name);
+    void grow();
+    uint32_t intern(std::string_view name);
+    uint32_t intern(std::string_view name, uint32_t h);
+    void parseState(std::string_view line, size_t lineNumber);
+    void parseTransition(std::string_view line, size_t lineNumber);
+    void flushTransitions();
+    void verify();
+    [[nodiscard]] size_t transitionLine(size_t index) const;
+    [[nodiscard]] std::string_view lineAt(size_t lineNumber) const;
+
+public:
+    explicit Parser(const std::string& file_);
+
+    [[nodiscard]] const std::vector<char>& getSigma() const;
+    [[nodiscard]] size_t getStateCount() const;
+    [[nodiscard]] std::string_view getName(uint32_t state) const;
+    [[nodiscard]] const std::vector<uint32_t>& getDeclarations() const;
+    [[nodiscard]] const std::vector<Transition>& getTransitions() const;
+    [[nodiscard]] bool isInitial(uint32_t state) const;
+    [[nodiscard]] bool isFinal(uint32_t state) const;
+
+    ~Parser() = default;
+};
\ No newline at end of file
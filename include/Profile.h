@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class FiniteAutomaton;
+
+// Opt-in hot-path counters, enabled by configuring with -DDFA_NFA_PROFILE=ON.
+// Each thread counts into its own tables; collect() merges them once matching has finished.
+class Profile {
+public:
+#if defined(DFA_NFA_PROFILE)
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+    static constexpr size_t reportLimit = 10;
+
+    struct Counters {
+        std::vector<uint64_t> visits;
+        std::unordered_map<uint64_t, uint64_t> transitions;
+        std::unordered_map<size_t, uint64_t> rejectPositions;
+        uint64_t accepted = 0;
+        uint64_t rejected = 0;
+
+        void visit(const size_t state) {
+            if (state >= visits.size()) {
+                visits.resize(state + 1, 0);
+            }
+            ++visits[state];
+        }
+
+        void transition(const size_t state, const char symbol) {
+            visit(state);
+            ++transitions[static_cast<uint64_t>(state) << 8 | static_cast<unsigned char>(symbol)];
+        }
+
+        void result(const bool accepts, const size_t position) {
+            if (accepts) {
+                ++accepted;
+            } else {
+                ++rejected;
+                ++rejectPositions[position];
+            }
+        }
+    };
+
+    struct Report {
+        uint64_t accepted = 0;
+        uint64_t rejected = 0;
+        std::vector<std::pair<std::string, uint64_t>> states;
+        std::vector<std::pair<std::string, uint64_t>> transitions;
+        std::vector<std::pair<size_t, uint64_t>> rejectPositions;
+    };
+
+    static Counters& local(const FiniteAutomaton* automaton);
+    static Report collect(const FiniteAutomaton& automaton);
+    static void print(const std::string& name, const Report& report, std::ostream& out);
+};
+
+#if defined(DFA_NFA_PROFILE)
+#define DFA_NFA_PROFILE_SCOPE(automaton) Profile::Counters& profileCounters = Profile::local(automaton)
+#define DFA_NFA_PROFILE_VISIT(state) profileCounters.visit(state)
+#define DFA_NFA_PROFILE_TRANSITION(state, symbol) profileCounters.transition(state, symbol)
+#define DFA_NFA_PROFILE_RESULT(accepts, position) profileCounters.result(accepts, position)
+#else
+#define DFA_NFA_PROFILE_SCOPE(automaton) static_cast<void>(0)
+#define DFA_NFA_PROFILE_VISIT(state) static_cast<void>(sizeof(state))
+#define DFA_NFA_PROFILE_TRANSITION(state, symbol) static_cast<void>(sizeof(state) + sizeof(symbol))
+#define DFA_NFA_PROFILE_RESULT(accepts, position) static_cast<void>(sizeof(accepts) + sizeof(position))
+#endif
\ No newline at end of file
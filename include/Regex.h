@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <NFA.h>
+
+class Regex {
+    struct Fragment {
+        size_t start;
+        size_t accept;
+    };
+
+    std::string_view pattern;
+    size_t position = 0;
+    NFA& nfa;
+    // Collected while parsing and handed to the NFA in one go, since its edges are stored per source state.
+    std::vector<Parser::Transition> transitions;
+
+    Regex(std::string_view pattern_, NFA& nfa_);
+
+    size_t newState();
+    void connect(size_t from, char symbol, size_t to);
+    void link(size_t from, size_t to);
+
+    Fragment parseAlternation();
+    Fragment parseConcatenation();
+    Fragment parseRepetition();
+    Fragment parseAtom();
+    Fragment parseClass();
+    char parseLiteral();
+
+    [[nodiscard]] bool atEnd() const;
+    [[noreturn]] void fail(const std::string& reason) const;
+
+public:
+    static NFA compile(std::string_view pattern);
+};
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Writes match results in one of several formats. Output is collected in a large buffer and handed to the
+// stream in blocks, so no line is flushed on its own.
+class Reporter {
+public:
+    enum class Format { Human, Csv, JsonLines, Bitmap };
+
+    static constexpr size_t bufferCapacity = 1 << 20;
+
+private:
+    std::ostream& out;
+    std::string buffer;
+
+protected:
+    void write(const std::string_view text) {
+        buffer += text;
+    }
+
+    void write(const char symbol) {
+        buffer += symbol;
+    }
+
+    void writeNumber(uint64_t value);
+
+    void endRecord() {
+        if (buffer.size() >= bufferCapacity) {
+            flush();
+        }
+    }
+
+public:
+    explicit Reporter(std::ostream& out_);
+
+    static std::unique_ptr<Reporter> create(Format format, std::ostream& out);
+    static std::optional<Format> parseFormat(std::string_view name);
+
+    virtual void beginConfig(const std::string& config, size_t wordCount) = 0;
+    virtual void result(std::string_view word, size_t index, bool accepted) = 0;
+    virtual void endConfig() {}
+
+    void flush();
+
+    virtual ~Reporter();
+};
+
+class HumanReporter : public Reporter {
+public:
+    using Reporter::Reporter;
+
+    void beginConfig(const std::string& config, size_t wordCount) override;
+    void result(std::string_view word, size_t index, bool accepted) override;
+};
+
+class CsvReporter : public Reporter {
+    std::string config;
+    bool header = true;
+
+public:
+    using Reporter::Reporter;
+
+    void beginConfig(const std::string& config_, size_t wordCount) override;
+    void result(std::string_view word, size_t index, bool accepted) override;
+};
+
+class JsonLinesReporter : public Reporter {
+    std::string config;
+
+    void writeString(std::string_view text);
+
+public:
+    using Reporter::Reporter;
+
+    void beginConfig(const std::string& config_, size_t wordCount) override;
+    void result(std::string_view word, size_t index, bool accepted) override;
+};
+
+// Per config: the config path and a newline, the word count as a little-endian uint64, then one bit per word
+// (least significant bit first), padded to a whole byte.
+class BitmapReporter : public Reporter {
+    uint8_t pending = 0;
+    size_t pendingBits = 0;
+
+public:
+    using Reporter::Reporter;
+
+    void beginConfig(const std::string& config, size_t wordCount) override;
+    void result(std::string_view word, size_t index, bool accepted) override;
+    void endConfig() override;
+};
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class StateSet {
+    std::vector<uint64_t> blocks;
+    size_t count = 0;
+
+public:
+    StateSet() = default;
+    explicit StateSet(const size_t size) : blocks((size + 63) / 64, 0), count(size) {}
+
+    void resize(const size_t size) {
+        blocks.assign((size + 63) / 64, 0);
+        count = size;
+    }
+
+    // Replaces the contents with a set of `size` states stored as packed 64-bit words, as in a compiled image.
+    void assign(const uint64_t* words, const size_t size) {
+        blocks.assign(words, words + (size + 63) / 64);
+        count = size;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return count;
+    }
+
+    void clear() {
+        std::fill(blocks.begin(), blocks.end(), 0);
+    }
+
+    void insert(const size_t state) {
+        blocks[state >> 6] |= uint64_t{1} << (state & 63);
+    }
+
+    [[nodiscard]] bool contains(const size_t state) const {
+        return blocks[state >> 6] >> (state & 63) & 1;
+    }
+
+    void unite(const StateSet& other) {
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            blocks[i] |= other.blocks[i];
+        }
+    }
+
+    [[nodiscard]] bool intersects(const StateSet& other) const {
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            if (blocks[i] & other.blocks[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool empty() const {
+        for (const auto& block : blocks) {
+            if (block) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            for (uint64_t block = blocks[i]; block; block &= block - 1) {
+                visit(i * 64 + std::countr_zero(block));
+            }
+        }
+    }
+
+    [[nodiscard]] size_t hash() const {
+        uint64_t h = 0xcbf29ce484222325;
+        for (const auto& block : blocks) {
+            h = (h ^ block) * 0x100000001b3;
+        }
+        return h ^ (h >> 32);
+    }
+
+    bool operator==(const StateSet& other) const = default;
+};
+
+template <>
+struct std::hash<StateSet> {
+    size_t operator()(const StateSet& set) const noexcept {
+        return set.hash();
+    }
+};
\ No newline at end of file
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+template <size_t N>
+struct FixedString {
+    char data[N]{};
+
+    constexpr FixedString(const char (&text)[N]) {
+        std::copy_n(text, N, data);
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const {
+        return {data, N - 1};
+    }
+};
+
+// A DFA whose configuration is a compile-time string in the usual line-based Sigma/States/Transitions format, e.g.
+//     using EvenA = StaticDFA<R"(Sigma:
+//     a
+//     End
+//     States:
+//     even, S, F
+//     odd
+//     End
+//     Transitions:
+//     even, a, odd
+//     odd, a, even
+//     End
+//     )">;
+//     static_assert(EvenA::process("aa") && !EvenA::process("a"));
+// Parsing and table construction happen during compilation; a malformed configuration does not compile.
+// The tables are static constexpr data, and process() folds away entirely for constant words. For runtime words it
+// walks those constant tables; DFA_NFA_codegen emits the switch-per-state form when that is wanted instead.
+template <FixedString Config>
+class StaticDFA {
+    enum class Section { None, Sigma, States, Transitions };
+
+    static constexpr std::string_view text = Config.view();
+    static constexpr size_t maxTokens = 8;
+
+    struct Tokens {
+        std::array<std::string_view, maxTokens> items{};
+        size_t count = 0;
+    };
+
+    static constexpr void fail(const char* reason) {
+        throw std::invalid_argument(reason);
+    }
+
+    static constexpr std::string_view trim(std::string_view token) {
+        while (!token.empty() && token.front() == ' ') {
+            token.remove_prefix(1);
+        }
+        while (!token.empty() && token.back() == ' ') {
+            token.remove_suffix(1);
+        }
+        return token;
+    }
+
+    static constexpr Tokens split(std::string_view line) {
+        Tokens tokens;
+        while (true) {
+            if (tokens.count == maxTokens) {
+                fail("Too many comma-separated fields on one line");
+            }
+            const size_t comma = line.find(',');
+            tokens.items[tokens.count++] = trim(line.substr(0, comma));
+            if (comma == std::string_view::npos) {
+                return tokens;
+            }
+            line.remove_prefix(comma + 1);
+        }
+    }
+
+    // Mirrors Parser: keyword lines switch sections, empty and '#' lines are skipped, '\r' endings are dropped.
+    template <typename Visitor>
+    static constexpr void forEachLine(Visitor&& visit) {
+        Section section = Section::None;
+        size_t position = 0;
+        while (position < text.size()) {
+            size_t end = text.find('\n', position);
+            end = end == std::string_view::npos ? text.size() : end;
+            std::string_view line = text.substr(position, end - position);
+            position = end + 1;
+
+            if (line.ends_with('\r')) {
+                line.remove_suffix(1);
+            }
+            if (line.find("Sigma") != std::string_view::npos) {
+                section = Section::Sigma;
+            } else if (line.find("States") != std::string_view::npos) {
+                section = Section::States;
+            } else if (line.find("Transitions") != std::string_view::npos) {
+                section = Section::Transitions;
+            } else if (line.find("End") != std::string_view::npos) {
+                section = Section::None;
+            } else if (!line.empty() && line.front() != '#' && section != Section::None) {
+                visit(section, line);
+            }
+        }
+    }
+
+    struct Counts {
+        size_t states = 0;
+        size_t symbols = 0;
+    };
+
+    static constexpr Counts count() {
+        Counts counts;
+        std::array<bool, 256> seen{};
+        forEachLine([&](const Section section, const std::string_view line) {
+            if (section == Section::States) {
+                ++counts.states;
+            } else if (section == Section::Sigma && !seen[static_cast<unsigned char>(line.front())]) {
+                seen[static_cast<unsigned char>(line.front())] = true;
+                ++counts.symbols;
+            }
+        });
+        if (counts.states == 0) {
+            fail("There are no states declared for this DFA");
+        }
+        return counts;
+    }
+
+    static constexpr Counts counts = count();
+
+public:
+    static constexpr int32_t deadState = -1;
+    static constexpr size_t stateCount = counts.states;
+    // Class 0 collects every byte outside Sigma and always leads to the dead state.
+    static constexpr size_t classCount = counts.symbols + 1;
+
+    struct Tables {
+        std::array<uint8_t, 256> classMap{};
+        std::array<int32_t, stateCount * classCount> table{};
+        std::array<bool, stateCount> finalStates{};
+        int32_t start = deadState;
+    };
+
+private:
+    static constexpr Tables build() {
+        Tables tables;
+        tables.table.fill(deadState);
+
+        std::array<std::string_view, stateCount> names{};
+        size_t declared = 0;
+        uint8_t nextClass = 1;
+        bool hasFinalState = false;
+
+        const auto find = [&](const std::string_view name) {
+            for (size_t i = 0; i < declared; ++i) {
+                if (names[i] == name) {
+                    return static_cast<int32_t>(i);
+                }
+            }
+            return deadState;
+        };
+
+        forEachLine([&](const Section section, const std::string_view line) {
+            if (section == Section::Sigma) {
+                auto& byteClass = tables.classMap[static_cast<unsigned char>(line.front())];
+                byteClass = byteClass ? byteClass : nextClass++;
+            } else if (section == Section::States) {
+                const Tokens tokens = split(line);
+                std::string_view name;
+                bool isInitial = false, isFinal = false;
+                for (size_t i = 0; i < tokens.count; ++i) {
+                    if (tokens.items[i] == "S") {
+                        isInitial = true;
+                    } else if (tokens.items[i] == "F") {
+                        isFinal = true;
+                    } else {
+                        name = tokens.items[i];
+                    }
+                }
+                if (name.empty()) {
+                    fail("State must have a name");
+                }
+                if (find(name) != deadState) {
+                    fail("State is declared more than once");
+                }
+                if (isInitial) {
+                    if (tables.start != deadState) {
+                        fail("Initial state should be unique");
+                    }
+                    tables.start = static_cast<int32_t>(declared);
+                }
+                tables.finalStates[declared] = isFinal;
+                hasFinalState = hasFinalState || isFinal;
+                names[declared++] = name;
+            }
+        });
+
+        if (tables.start == deadState) {
+            fail("An initial state is required");
+        }
+        if (!hasFinalState) {
+            fail("At least one final state required");
+        }
+
+        forEachLine([&](const Section section, const std::string_view line) {
+            if (section != Section::Transitions) {
+                return;
+            }
+            const Tokens tokens = split(line);
+            if (tokens.count < 3) {
+                fail("A transition needs a source, a symbol and a target");
+            }
+            const std::string_view symbol = tokens.items[1];
+            if (symbol.size() != 1) {
+                fail("The symbol should be an unique character");
+            }
+            const uint8_t byteClass = tables.classMap[static_cast<unsigned char>(symbol.front())];
+            if (!byteClass) {
+                fail("The symbol is not defined in Sigma");
+            }
+            const int32_t from = find(tokens.items[0]), to = find(tokens.items[2]);
+            if (from == deadState || to == deadState) {
+                fail("There are undefined states");
+            }
+            int32_t& target = tables.table[static_cast<size_t>(from) * classCount + byteClass];
+            if (target != deadState) {
+                fail("There are mutliple states leading from one state with the same symbol");
+            }
+            target = to;
+        });
+
+        return tables;
+    }
+
+public:
+    static constexpr Tables tables = build();
+
+    static constexpr bool process(const std::string_view word) {
+        int32_t state = tables.start;
+        for (const char symbol : word) {
+            state = tables.table[static_cast<size_t>(state) * classCount + tables.classMap[static_cast<unsigned char>(symbol)]];
+            if (state == deadState) {
+                return false;
+            }
+        }
+        return tables.finalStates[state];
+    }
+};
\ No newline at end of file
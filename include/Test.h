@@ -1,30 +1,41 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
+#include <memory>
+#include <span>
 #include <string>
-#include <fstream>
+#include <string_view>
 #include <filesystem>
+#include <stdexcept>
+#include <type_traits>
 
 #include <UserWarn.h>
+#include <Classifier.h>
+#include <CombinedNFA.h>
 #include <DFA.h>
 #include <NFA.h>
+#include <Profile.h>
+#include <Reporter.h>
+#include <ThreadPool.h>
+#include <WordSource.h>
 
 template <typename FA>
 class Test {
 private:
-    std::vector<std::string> words;
+    std::unique_ptr<WordSource> words;
     std::string configPath;
+    std::unique_ptr<ThreadPool> pool;
+    std::shared_ptr<Reporter> reporter = std::make_shared<HumanReporter>(std::cout);
+    bool combined = false;
 
     void setWords(const std::string& filename) {
-        std::ifstream f(filename);
-        std::string line;
-        if (!f.is_open()) {
-            UserWarn("Provided file does not exist: " + filename);
+        try {
+            this->words = std::make_unique<WordSource>(filename);
+        } catch (const std::runtime_error& error) {
+            UserWarn(error.what());
         }
-        while (std::getline(f, line)) {
-            this->words.push_back(line);
-        }
-        f.close();
     }
 
     void setConfigPath() {
@@ -36,29 +47,192 @@ class Test {
         return this->configPath;
     }
 
-    static bool getResult(const FA& custom, const std::string& word) {
+    static bool getResult(const FA& custom, const std::string_view word) {
         return custom.process(word);
     }
 
+    void evaluate(const FA& custom, const WordSource::Chunk& chunk, std::vector<uint8_t>& results) const {
+        size_t index = chunk.firstWord;
+        if constexpr (requires { custom.processBatch(std::span<const std::string_view>{}); }) {
+            thread_local std::vector<std::string_view> batch;
+            batch.clear();
+            WordSource::forEach(chunk.text, [&](const std::string_view word) {
+                batch.push_back(word);
+            });
+            const auto batchResults = custom.processBatch(batch);
+            for (size_t i = 0; i < batch.size(); ++i) {
+                results[index++] = batchResults[i];
+            }
+        } else {
+            WordSource::forEach(chunk.text, [&](const std::string_view word) {
+                results[index++] = getResult(custom, word);
+            });
+        }
+    }
+
+    void evaluate(const FA& custom, std::vector<uint8_t>& results) const {
+        for (const auto& chunk : words->getChunks()) {
+            evaluate(custom, chunk, results);
+        }
+    }
+
+    void schedule(const FA& custom, std::vector<uint8_t>& results) {
+        for (const auto& chunk : words->getChunks()) {
+            pool->submit([this, &custom, &results, &chunk] {
+                evaluate(custom, chunk, results);
+            });
+        }
+    }
+
+    std::vector<std::string> getConfigs() {
+        std::vector<std::string> configs;
+        std::string currentPath = getConfigPath();
+        for (const auto& entry : std::filesystem::directory_iterator(currentPath)) {
+            if (entry.is_regular_file()) {
+                configs.push_back(currentPath + entry.path().filename().string());
+            }
+        }
+        std::sort(configs.begin(), configs.end());
+        return configs;
+    }
+
+    void printResults(const std::vector<uint8_t>& results) const {
+        size_t i = 0;
+        for (const auto& chunk : words->getChunks()) {
+            WordSource::forEach(chunk.text, [&](const std::string_view word) {
+                reporter->result(word, i, results[i]);
+                ++i;
+            });
+        }
+        reporter->endConfig();
+    }
+
+    static void classify(Classifier& classifier, const WordSource::Chunk& chunk, std::vector<std::vector<uint8_t>>& results) {
+        size_t index = chunk.firstWord;
+        WordSource::forEach(chunk.text, [&](const std::string_view word) {
+            for (const auto& config : classifier.classify(word)) {
+                results[config][index] = 1;
+            }
+            ++index;
+        });
+    }
+
+    // All configurations are merged into one automaton with NFA semantics, so every word is scanned once
+    // however many configurations there are. DFA configurations are first checked one by one, in the order the
+    // other modes load them; since every configuration is loaded before any result is printed, a configuration
+    // error has no header.
+    void runCombined(const std::vector<std::string>& configs) {
+        if constexpr (std::is_same_v<FA, DFA>) {
+            for (const auto& config : configs) {
+                DFA::validateConfig(config);
+            }
+        }
+        const CombinedNFA automaton(configs);
+        std::vector<std::vector<uint8_t>> results(configs.size(), std::vector<uint8_t>(words->size()));
+        if (!pool) {
+            Classifier classifier(automaton);
+            for (const auto& chunk : words->getChunks()) {
+                classify(classifier, chunk, results);
+            }
+        } else {
+            for (const auto& chunk : words->getChunks()) {
+                pool->submit([&automaton, &results, &chunk] {
+                    Classifier classifier(automaton);
+                    classify(classifier, chunk, results);
+                });
+            }
+            pool->wait();
+        }
+
+        for (size_t i = 0; i < configs.size(); ++i) {
+            reporter->beginConfig(configs[i], words->size());
+            printResults(results[i]);
+        }
+        reporter->flush();
+    }
+
+    static void printProfiles(const std::vector<std::string>& configs, const std::vector<Profile::Report>& profiles) {
+        for (size_t i = 0; i < profiles.size(); ++i) {
+            Profile::print(configs[i], profiles[i], std::cerr);
+        }
+    }
+
 public:
     explicit Test(const std::string& filename) {
         setWords(filename);
         setConfigPath();
     }
 
+    void setReporter(std::shared_ptr<Reporter> reporter_) {
+        reporter = std::move(reporter_);
+    }
+
+    void setCombined(const bool combined_) {
+        combined = combined_;
+    }
+
+    void setThreads(const size_t threads) {
+        pool = threads > 1 ? std::make_unique<ThreadPool>(threads) : nullptr;
+    }
+
     void run() {
-        std::string currentPath = getConfigPath();
-        for (const auto& entry : std::filesystem::directory_iterator(currentPath)) {
-            if (entry.is_regular_file()) {
-                std::string currentConfig = currentPath + entry.path().filename().string();
-                std::cout << std::endl << "Configuration: " << currentConfig << std::endl;
+        const auto configs = getConfigs();
+        if (combined) {
+            runCombined(configs);
+            return;
+        }
+
+        std::vector<Profile::Report> profiles;
+        if (!pool) {
+            std::vector<uint8_t> results(words->size());
+            for (const auto& currentConfig : configs) {
+                // Flushed before loading, so a configuration error still follows its header.
+                reporter->beginConfig(currentConfig, words->size());
+                reporter->flush();
                 FA custom(currentConfig);
-                for (const auto& word : words) {
-                    std::cout << "Word: " << word << " >> ";
-                    getResult(custom, word) ? std::cout << "\033[32m" << "Accepted!" << "\033[0m" << std::endl : std::cout << "\033[31m" << "Rejected!"<< "\033[0m" << std::endl;
+                evaluate(custom, results);
+                printResults(results);
+                if constexpr (Profile::enabled) {
+                    profiles.push_back(Profile::collect(custom));
                 }
             }
+            reporter->flush();
+            printProfiles(configs, profiles);
+            return;
+        }
+
+        // Every config is loaded by its own task, which then fans its word chunks out as further tasks.
+        // Configuration errors are kept until the pool is idle and reported in serial order.
+        std::vector<std::unique_ptr<FA>> automata(configs.size());
+        std::vector<std::unique_ptr<UserWarn::Error>> errors(configs.size());
+        std::vector<std::vector<uint8_t>> results(configs.size(), std::vector<uint8_t>(words->size()));
+        for (size_t i = 0; i < configs.size(); ++i) {
+            pool->submit([this, &configs, &automata, &errors, &results, i] {
+                try {
+                    const UserWarn::Deferral deferral;
+                    automata[i] = std::make_unique<FA>(configs[i]);
+                } catch (const UserWarn::Error& error) {
+                    errors[i] = std::make_unique<UserWarn::Error>(error);
+                    return;
+                }
+                schedule(*automata[i], results[i]);
+            });
+        }
+        pool->wait();
+
+        for (size_t i = 0; i < configs.size(); ++i) {
+            reporter->beginConfig(configs[i], words->size());
+            if (errors[i]) {
+                reporter->flush();
+                errors[i]->report();
+            }
+            printResults(results[i]);
+            if constexpr (Profile::enabled) {
+                profiles.push_back(Profile::collect(*automata[i]));
+            }
         }
+        reporter->flush();
+        printProfiles(configs, profiles);
     }
 
     ~Test() = default;
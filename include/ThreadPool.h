@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+    struct Worker {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable idle;
+    std::atomic<size_t> queued = 0;
+    std::atomic<size_t> pending = 0;
+    std::atomic<size_t> nextWorker = 0;
+    std::exception_ptr failure;
+    bool stopping = false;
+
+    static thread_local ThreadPool* currentPool;
+    static thread_local size_t currentWorker;
+
+    bool tryRun(size_t self);
+    void workerLoop(size_t self);
+
+public:
+    explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency());
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    void wait();
+
+    [[nodiscard]] size_t size() const;
+
+    ~ThreadPool();
+};
\ No newline at end of file
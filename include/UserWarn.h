@@ -1,13 +1,41 @@
 #pragma once
 
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <iostream>
 
 class UserWarn {
-    static void configurationError(const std::string& reason, const std::string& line = "");
+    static thread_local bool deferred;
+
+    [[noreturn]] static void configurationError(const std::string& reason, const std::string& line = "", size_t lineNumber = 0);
 
 public:
+    // Thrown instead of exiting while a Deferral is alive on the reporting thread.
+    class Error : public std::runtime_error {
+        std::string line;
+        size_t lineNumber;
+
+    public:
+        Error(const std::string& reason, std::string line_, size_t lineNumber_);
+
+        // Prints the error the way UserWarn would have and exits.
+        [[noreturn]] void report() const;
+    };
+
+    // Lets a worker thread hand a configuration error back to the thread that owns the output.
+    class Deferral {
+        bool previous;
+
+    public:
+        Deferral();
+        Deferral(const Deferral&) = delete;
+        Deferral& operator=(const Deferral&) = delete;
+        ~Deferral();
+    };
+
     explicit UserWarn(const std::string& reason);
     explicit UserWarn(const std::string& reason, const std::string& line);
+    explicit UserWarn(const std::string& reason, std::string_view line, size_t lineNumber);
     ~UserWarn() = default;
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <MappedFile.h>
+
+class WordSource {
+public:
+    static constexpr size_t defaultChunkBytes = 256 << 10;
+
+    struct Chunk {
+        std::string_view text;
+        size_t firstWord = 0;
+        size_t wordCount = 0;
+    };
+
+private:
+    MappedFile file;
+    std::vector<Chunk> chunks;
+    size_t wordCount = 0;
+
+public:
+    explicit WordSource(const std::string& filename, size_t chunkBytes = defaultChunkBytes);
+
+    template <typename Visitor>
+    static void forEach(const std::string_view text, Visitor&& visit) {
+        const char* position = text.data();
+        const char* const end = position + text.size();
+        while (position < end) {
+            const auto* newline = static_cast<const char*>(std::memchr(position, '\n', end - position));
+            const char* lineEnd = newline ? newline : end;
+            std::string_view word(position, lineEnd - position);
+            if (word.ends_with('\r')) {
+                word.remove_suffix(1);
+            }
+            visit(word);
+            position = lineEnd + 1;
+        }
+    }
+
+    [[nodiscard]] const std::vector<Chunk>& getChunks() const;
+    [[nodiscard]] size_t size() const;
+
+    ~WordSource() = default;
+};
\ No newline at end of file
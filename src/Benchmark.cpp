@@ -0,0 +1,342 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <DFA.h>
+#include <FiniteAutomaton.h>
+#include <Generator.h>
+#include <LazyDFA.h>
+#include <NFA.h>
+#include <Parser.h>
+#include <Setup.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::vector<size_t> sizes{16, 256, 1024};
+    std::vector<size_t> lengths{8, 64, 512};
+    size_t alphabet = 4;
+    double acceptRatio = 0.5;
+    size_t bytes = 256 << 10;
+    size_t latencySamples = 10000;
+    size_t warmup = 1;
+    size_t repetitions = 5;
+    size_t subsetLimit = 1 << 14;
+    std::string output;
+};
+
+struct Summary {
+    double p50 = 0;
+    double p99 = 0;
+    double mean = 0;
+};
+
+Summary summarize(std::vector<double> samples) {
+    Summary summary;
+    if (samples.empty()) {
+        return summary;
+    }
+    std::sort(samples.begin(), samples.end());
+    summary.p50 = samples[samples.size() / 2];
+    summary.p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    for (const double sample : samples) {
+        summary.mean += sample;
+    }
+    summary.mean /= static_cast<double>(samples.size());
+    return summary;
+}
+
+// Runs `body` warmup + repetitions times and returns the timed repetitions in seconds.
+std::vector<double> repeat(const Options& options, const std::function<void()>& body) {
+    std::vector<double> samples;
+    for (size_t i = 0; i < options.warmup + options.repetitions; ++i) {
+        const auto begin = Clock::now();
+        body();
+        const std::chrono::duration<double> elapsed = Clock::now() - begin;
+        if (i >= options.warmup) {
+            samples.push_back(elapsed.count());
+        }
+    }
+    return samples;
+}
+
+class Report {
+    std::ostringstream out;
+    bool first = true;
+
+public:
+    void record(const std::string& name, const std::string& engine, const size_t states, const size_t length, const std::vector<std::pair<std::string, double>>& metrics) {
+        out << (first ? "\n" : ",\n") << "    {\"name\": \"" << name << "\", \"engine\": \"" << engine << "\", \"states\": " << states;
+        if (length) {
+            out << ", \"word_length\": " << length;
+        }
+        for (const auto& [key, value] : metrics) {
+            out << ", \"" << key << "\": " << value;
+        }
+        out << "}";
+        first = false;
+    }
+
+    [[nodiscard]] std::string str() const {
+        return "{\n  \"benchmarks\": [" + out.str() + "\n  ]\n}\n";
+    }
+};
+
+// The load path Parser replaced, kept as the baseline: Setup copies every line into a string, each line is
+// tokenized through an istringstream, and states are shared_ptr nodes looked up by name.
+struct LegacyState {
+    std::string name;
+    bool initial = false;
+    bool final = false;
+    std::unordered_multimap<char, std::shared_ptr<LegacyState>> transitions;
+};
+
+size_t loadLegacy(const std::string& path) {
+    const Setup setup(path);
+    std::unordered_set<char> sigma;
+    for (const auto& line : setup.getSigma()) {
+        sigma.insert(line[0]);
+    }
+
+    std::vector<std::shared_ptr<LegacyState>> states;
+    std::unordered_map<std::string, std::shared_ptr<LegacyState>> stateMap;
+    for (const auto& line : setup.getStates()) {
+        auto state = std::make_shared<LegacyState>();
+        std::istringstream stream(line);
+        std::string token;
+        while (std::getline(stream, token, ',')) {
+            token.erase(0, token.find_first_not_of(' '));
+            token.erase(token.find_last_not_of(' ') + 1);
+            if (token == "S") {
+                state->initial = true;
+            } else if (token == "F") {
+                state->final = true;
+            } else {
+                state->name = token;
+            }
+        }
+        stateMap[state->name] = state;
+        states.push_back(state);
+    }
+
+    size_t linked = 0;
+    for (const auto& line : setup.getTransitions()) {
+        std::istringstream stream(line);
+        std::string from, to, token;
+        char symbol = 0;
+        for (int index = 0; std::getline(stream, token, ','); ++index) {
+            token.erase(0, token.find_first_not_of(' '));
+            token.erase(token.find_last_not_of(' ') + 1);
+            switch (index) {
+                case 0: from = token; break;
+                case 1: symbol = token[0]; break;
+                case 2: to = token; break;
+                default: break;
+            }
+        }
+        if (sigma.contains(symbol) && stateMap.contains(from) && stateMap.contains(to)) {
+            stateMap[from]->transitions.insert({symbol, stateMap[to]});
+            ++linked;
+        }
+    }
+    return linked;
+}
+
+// Parser output copied into the dense state arrays every engine is built from.
+class LoadedAutomaton : public FiniteAutomaton {
+public:
+    explicit LoadedAutomaton(const std::string& path) {
+        load(Parser(path));
+    }
+};
+
+void benchmarkParse(const Options& options, Report& report, const std::string& path, const size_t states) {
+    const double bytes = static_cast<double>(std::filesystem::file_size(path));
+    const auto legacy = summarize(repeat(options, [&] { loadLegacy(path); }));
+    report.record("parse", "legacy", states, 0, {{"seconds_p50", legacy.p50}, {"bytes_per_second", bytes / legacy.p50}});
+    const auto parser = summarize(repeat(options, [&] { Parser parsed(path); }));
+    report.record("parse", "parser", states, 0, {{"seconds_p50", parser.p50}, {"bytes_per_second", bytes / parser.p50}});
+    const auto loaded = summarize(repeat(options, [&] { LoadedAutomaton automaton(path); }));
+    report.record("parse", "load", states, 0, {
+        {"seconds_p50", loaded.p50},
+        {"bytes_per_second", bytes / loaded.p50},
+        {"speedup_over_legacy", legacy.p50 / loaded.p50}
+    });
+}
+
+template <typename Engine>
+void benchmarkProcess(const Options& options, Report& report, const std::string& engine, const size_t states, const size_t length, const std::vector<std::string>& words, Engine&& process) {
+    size_t accepted = 0;
+    const auto throughput = summarize(repeat(options, [&] {
+        accepted = 0;
+        for (const auto& word : words) {
+            accepted += process(word);
+        }
+    }));
+
+    std::vector<double> latencies;
+    const size_t samples = std::min(words.size(), options.latencySamples);
+    for (size_t i = 0; i < samples; ++i) {
+        const auto begin = Clock::now();
+        [[maybe_unused]] volatile const bool result = process(words[i]);
+        latencies.push_back(std::chrono::duration<double, std::nano>(Clock::now() - begin).count());
+    }
+    const auto latency = summarize(latencies);
+
+    const double count = static_cast<double>(words.size());
+    report.record("process", engine, states, length, {
+        {"words_per_second", count / throughput.p50},
+        {"bytes_per_second", count * static_cast<double>(length) / throughput.p50},
+        {"latency_ns_p50", latency.p50},
+        {"latency_ns_p99", latency.p99},
+        {"accepted", static_cast<double>(accepted)}
+    });
+}
+
+void benchmarkSize(const Options& options, Report& report, const std::filesystem::path& directory, const size_t states) {
+    const std::string dfaPath = (directory / ("dfa" + std::to_string(states) + ".in")).string();
+    const std::string nfaPath = (directory / ("nfa" + std::to_string(states) + ".in")).string();
+    const Generator dfaGenerator({states, options.alphabet, options.alphabet, 1.0, 0.5, states});
+    const Generator nfaGenerator({states, options.alphabet, options.alphabet - 1, 1.25, 0.5, states + 1});
+    dfaGenerator.writeConfig(dfaPath);
+    nfaGenerator.writeConfig(nfaPath);
+
+    benchmarkParse(options, report, nfaPath, states);
+
+    const auto dfaBuild = summarize(repeat(options, [&] { DFA built(dfaPath); }));
+    report.record("construct", "dfa", states, 0, {{"seconds_p50", dfaBuild.p50}});
+    const auto nfaBuild = summarize(repeat(options, [&] { NFA built(nfaPath); }));
+    report.record("construct", "nfa", states, 0, {{"seconds_p50", nfaBuild.p50}});
+
+    const DFA dfa(dfaPath);
+    const NFA nfa(nfaPath);
+    std::unique_ptr<DFA> subset;
+    try {
+        const auto begin = Clock::now();
+        subset = std::make_unique<DFA>(nfa, options.subsetLimit);
+        const std::chrono::duration<double> elapsed = Clock::now() - begin;
+        report.record("construct", "subset", states, 0, {{"seconds", elapsed.count()}, {"result_states", static_cast<double>(subset->getStateCount())}});
+    } catch (const std::runtime_error&) {
+        report.record("construct", "subset", states, 0, {{"exceeded_limit", static_cast<double>(options.subsetLimit)}});
+    }
+    LazyDFA lazy(nfa);
+
+    for (const size_t length : options.lengths) {
+        const size_t count = std::max<size_t>(1, options.bytes / std::max<size_t>(length, 1));
+        // Each automaton gets words drawn from its own language, so both see the requested accept ratio.
+        const auto dfaWords = dfaGenerator.corpus(count, length, length, options.acceptRatio);
+        const auto words = nfaGenerator.corpus(count, length, length, options.acceptRatio);
+        std::vector<std::string_view> views(dfaWords.begin(), dfaWords.end());
+
+        benchmarkProcess(options, report, "dfa", states, length, dfaWords, [&](const std::string_view word) { return dfa.process(word); });
+        size_t batchAccepted = 0;
+        const auto batch = summarize(repeat(options, [&] {
+            const auto results = dfa.processBatch(views);
+            batchAccepted = std::count(results.begin(), results.end(), true);
+        }));
+        report.record("process", "dfa-batch", states, length, {
+            {"words_per_second", static_cast<double>(count) / batch.p50},
+            {"bytes_per_second", static_cast<double>(count * length) / batch.p50},
+            {"accepted", static_cast<double>(batchAccepted)}
+        });
+        benchmarkProcess(options, report, "nfa", states, length, words, [&](const std::string_view word) { return nfa.process(word); });
+        benchmarkProcess(options, report, "lazy-dfa", states, length, words, [&](const std::string_view word) { return lazy.process(word); });
+        if (subset) {
+            benchmarkProcess(options, report, "subset-dfa", states, length, words, [&](const std::string_view word) { return subset->process(word); });
+        }
+    }
+}
+
+// A decimal count; std::stoul alone would accept "-1" and wrap it to SIZE_MAX.
+size_t parseCount(const std::string& text) {
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+        throw std::invalid_argument(text);
+    }
+    return std::stoul(text);
+}
+
+std::vector<size_t> parseList(const std::string& text) {
+    std::vector<size_t> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        values.push_back(parseCount(item));
+    }
+    return values;
+}
+
+int usage() {
+    std::cerr << "Usage: DFA_NFA_bench [--sizes=16,256,...] [--lengths=8,64,...] [--alphabet=N] [--accept-ratio=X] [--bytes=N] [--warmup=N] [--repetitions=N] [--output=file.json]" << std::endl;
+    return 1;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    const std::vector<std::string> arguments(argv + 1, argv + argc);
+    try {
+        for (const auto& argument : arguments) {
+            const size_t equals = argument.find('=');
+            const std::string key = argument.substr(0, equals);
+            const std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+            if (key == "--sizes") {
+                options.sizes = parseList(value);
+            } else if (key == "--lengths") {
+                options.lengths = parseList(value);
+            } else if (key == "--alphabet") {
+                options.alphabet = std::clamp<size_t>(parseCount(value), 2, Generator::symbols.size());
+            } else if (key == "--accept-ratio") {
+                options.acceptRatio = std::stod(value);
+                if (!(options.acceptRatio >= 0.0 && options.acceptRatio <= 1.0)) {
+                    return usage();
+                }
+            } else if (key == "--bytes") {
+                options.bytes = parseCount(value);
+            } else if (key == "--warmup") {
+                options.warmup = parseCount(value);
+            } else if (key == "--repetitions") {
+                options.repetitions = std::max<size_t>(1, parseCount(value));
+            } else if (key == "--output") {
+                options.output = value;
+            } else {
+                return usage();
+            }
+        }
+    } catch (const std::logic_error&) {
+        return usage();
+    }
+
+    const auto directory = std::filesystem::temp_directory_path() / "DFA_NFA_bench";
+    std::filesystem::create_directories(directory);
+
+    Report report;
+    for (const size_t states : options.sizes) {
+        benchmarkSize(options, report, directory, std::max<size_t>(states, 1));
+    }
+    std::filesystem::remove_all(directory);
+
+    if (options.output.empty()) {
+        std::cout << report.str();
+    } else {
+        std::ofstream file(options.output, std::ios::binary | std::ios::trunc);
+        if (!(file << report.str()) || !file.flush()) {
+            std::cerr << "Could not write benchmark report: " << options.output << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include <algorithm>
+#include <map>
+
+#include <ByteClasses.h>
+
+ByteClasses::ByteClasses(const std::span<const uint32_t> offsets, const std::span<const char> symbols, const std::span<const uint32_t> targets) {
+    std::array<size_t, alphabetSize> classSize{};
+    classSize[0] = alphabetSize;
+    size_t classCount = 1;
+
+    std::array<std::vector<uint32_t>, alphabetSize> byteTargets;
+    std::vector<unsigned char> used;
+    std::map<std::pair<uint8_t, std::vector<uint32_t>>, std::vector<unsigned char>> groups;
+
+    for (size_t state = 0; state + 1 < offsets.size(); ++state) {
+        for (uint32_t edge = offsets[state]; edge < offsets[state + 1]; ++edge) {
+            const auto byte = static_cast<unsigned char>(symbols[edge]);
+            if (byteTargets[byte].empty()) {
+                used.push_back(byte);
+            }
+            byteTargets[byte].push_back(targets[edge]);
+        }
+
+        for (const auto& byte : used) {
+            std::sort(byteTargets[byte].begin(), byteTargets[byte].end());
+            groups[{classMap[byte], std::move(byteTargets[byte])}].push_back(byte);
+            byteTargets[byte].clear();
+        }
+        used.clear();
+
+        for (const auto& [key, bytes] : groups) {
+            const uint8_t byteClass = key.first;
+            if (bytes.size() == classSize[byteClass]) {
+                continue;
+            }
+            classSize[byteClass] -= bytes.size();
+            classSize[classCount] = bytes.size();
+            for (const auto& byte : bytes) {
+                classMap[byte] = static_cast<uint8_t>(classCount);
+            }
+            ++classCount;
+        }
+        groups.clear();
+    }
+
+    representatives.assign(classCount, 0);
+    for (size_t byte = alphabetSize; byte-- > 0;) {
+        representatives[classMap[byte]] = static_cast<unsigned char>(byte);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include <algorithm>
+
+#include <Classifier.h>
+
+Classifier::Classifier(const CombinedNFA& nfa_, const size_t memoryBudget_, const size_t flushLimit_)
+    : nfa(nfa_), memoryBudget(memoryBudget_), flushLimit(flushLimit_), marks(nfa_.getStateCount(), 0) {
+    flush();
+}
+
+void Classifier::flush() {
+    subsets.clear();
+    emitted.clear();
+    subsetIds.clear();
+    table.clear();
+    accepted.clear();
+    cachedBytes = 0;
+
+    std::vector<uint32_t> initial = nfa.initialStates, emits;
+    settle(initial, emits);
+    addState(initial, emits);
+}
+
+int32_t Classifier::addState(const std::vector<uint32_t>& subset, const std::vector<uint32_t>& emits) {
+    const auto id = static_cast<int32_t>(subsets.size());
+    makeKey(subset, emits);
+    subsets.push_back(subset);
+    emitted.push_back(emits);
+    subsetIds.emplace(key, id);
+    table.resize(table.size() + nfa.classes.size(), unknownState);
+    accepted.emplace_back();
+    collectAccepted(subset, accepted.back());
+    cachedBytes += (2 * key.size() + accepted.back().size()) * sizeof(uint32_t) + nfa.classes.size() * sizeof(int32_t) + 12 * sizeof(void*);
+    return id;
+}
+
+void Classifier::makeKey(const std::vector<uint32_t>& subset, const std::vector<uint32_t>& emits) {
+    key.assign(subset.begin(), subset.end());
+    if (!emits.empty()) {
+        key.push_back(CombinedNFA::noState);
+        key.insert(key.end(), emits.begin(), emits.end());
+    }
+}
+
+// States are numbered configuration by configuration, so the owners of a sorted subset come out sorted too.
+void Classifier::collectAccepted(const std::vector<uint32_t>& subset, std::vector<uint32_t>& configs) const {
+    configs.clear();
+    for (const auto& state : subset) {
+        if (nfa.finals[state] && (configs.empty() || configs.back() != nfa.owners[state])) {
+            configs.push_back(nfa.owners[state]);
+        }
+    }
+}
+
+// Moves universal states out of the subset and lists their configurations in `emits`. The rest of each
+// configuration stays, so the subset does not remember which configurations were decided earlier in the word.
+void Classifier::settle(std::vector<uint32_t>& subset, std::vector<uint32_t>& emits) const {
+    emits.clear();
+    size_t kept = 0;
+    for (const auto& state : subset) {
+        if (!nfa.universal[state]) {
+            subset[kept++] = state;
+        } else if (emits.empty() || emits.back() != nfa.owners[state]) {
+            emits.push_back(nfa.owners[state]);
+        }
+    }
+    subset.resize(kept);
+}
+
+void Classifier::advance(const std::vector<uint32_t>& from, const uint8_t byteClass, std::vector<uint32_t>& to) {
+    to.clear();
+    const size_t stride = nfa.classes.size();
+    for (const auto& state : from) {
+        const size_t row = state * stride + byteClass;
+        for (uint32_t i = nfa.successorOffsets[row]; i < nfa.successorOffsets[row + 1]; ++i) {
+            const uint32_t target = nfa.successorTargets[i];
+            if (!marks[target]) {
+                marks[target] = 1;
+                to.push_back(target);
+            }
+        }
+    }
+    for (const auto& state : to) {
+        marks[state] = 0;
+    }
+    if (!std::is_sorted(to.begin(), to.end())) {
+        std::sort(to.begin(), to.end());
+    }
+}
+
+int32_t Classifier::transition(const int32_t state, const uint8_t byteClass, size_t& flushes) {
+    ++counters.misses;
+
+    advance(subsets[state], byteClass, scratch);
+    settle(scratch, scratchEmitted);
+    if (scratch.empty() && scratchEmitted.empty()) {
+        table[state * nfa.classes.size() + byteClass] = deadState;
+        return deadState;
+    }
+
+    makeKey(scratch, scratchEmitted);
+    if (const auto it = subsetIds.find(key); it != subsetIds.end()) {
+        table[state * nfa.classes.size() + byteClass] = it->second;
+        return it->second;
+    }
+
+    if (cachedBytes > memoryBudget) {
+        ++counters.flushes;
+        ++flushes;
+        flush();
+        return addState(scratch, scratchEmitted);
+    }
+
+    const int32_t next = addState(scratch, scratchEmitted);
+    table[state * nfa.classes.size() + byteClass] = next;
+    return next;
+}
+
+const std::vector<uint32_t>& Classifier::classify(const std::string_view word) {
+    if (nfa.initialStates.empty()) {
+        return none;
+    }
+
+    int32_t state = 0;
+    size_t flushes = 0;
+    wordEmitted.assign(emitted[0].begin(), emitted[0].end());
+
+    for (size_t position = 0; position < word.size(); ++position) {
+        const uint8_t byteClass = nfa.classes[static_cast<unsigned char>(word[position])];
+        const int32_t next = table[state * nfa.classes.size() + byteClass];
+        if (next != unknownState) {
+            ++counters.hits;
+            state = next;
+        } else {
+            state = transition(state, byteClass, flushes);
+        }
+
+        if (state == deadState) {
+            return finish(word, none);
+        }
+        wordEmitted.insert(wordEmitted.end(), emitted[state].begin(), emitted[state].end());
+        if (flushes > flushLimit) {
+            ++counters.fallbacks;
+            return simulate(subsets[state], word, position + 1);
+        }
+    }
+
+    return finish(word, accepted[state]);
+}
+
+// Emitted configurations still reject words with a byte outside their Sigma, which the scan no longer tracks for them.
+const std::vector<uint32_t>& Classifier::finish(const std::string_view word, const std::vector<uint32_t>& configs) {
+    if (wordEmitted.empty()) {
+        return configs;
+    }
+
+    CombinedNFA::ClassMask seen{};
+    for (const auto& symbol : word) {
+        const uint8_t byteClass = nfa.classes[static_cast<unsigned char>(symbol)];
+        seen[byteClass >> 6] |= uint64_t{1} << (byteClass & 63);
+    }
+
+    result = configs;
+    for (const auto& config : wordEmitted) {
+        bool inSigma = true;
+        for (size_t i = 0; i < seen.size(); ++i) {
+            inSigma = inSigma && !(seen[i] & ~nfa.sigmaClasses[config][i]);
+        }
+        if (inSigma) {
+            result.push_back(config);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+const std::vector<uint32_t>& Classifier::simulate(std::vector<uint32_t> current, const std::string_view word, const size_t position) {
+    std::vector<uint32_t> next;
+    for (size_t i = position; i < word.size() && !current.empty(); ++i) {
+        advance(current, nfa.classes[static_cast<unsigned char>(word[i])], next);
+        std::swap(current, next);
+    }
+    collectAccepted(current, fallbackAccepted);
+    return finish(word, fallbackAccepted);
+}
+
+const Classifier::Counters& Classifier::getCounters() const {
+    return counters;
+}
+
+size_t Classifier::getCachedStates() const {
+    return subsets.size();
+}
+
+void Classifier::resetCounters() {
+    counters = {};
+}
\ No newline at end of file
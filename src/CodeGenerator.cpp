@@ -0,0 +1,95 @@
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <CodeGenerator.h>
+
+std::string CodeGenerator::caseLabel(const unsigned char byte) {
+    std::ostringstream label;
+    if (std::isalnum(byte)) {
+        label << "case '" << static_cast<char>(byte) << "':";
+    } else {
+        label << "case " << static_cast<int>(byte) << ":";
+    }
+    return label.str();
+}
+
+std::string CodeGenerator::source(const DFA& dfa, const std::string& function, const std::string& origin) {
+    std::ostringstream out;
+    out << "// Generated by DFA_NFA_codegen from " << origin << ". Do not edit.\n";
+    out << "#include <string_view>\n\n";
+    out << "bool " << function << "(const std::string_view word) {\n";
+
+    if (dfa.start == DFA::deadState) {
+        out << "    return false;\n}\n";
+        return out.str();
+    }
+
+    out << "    const unsigned char* position = reinterpret_cast<const unsigned char*>(word.data());\n";
+    out << "    const unsigned char* const end = position + word.size();\n";
+    out << "    goto state" << dfa.start << ";\n";
+
+    const size_t stride = dfa.classes.size();
+    const size_t stateCount = dfa.finalStates.size();
+    for (size_t state = 0; state < stateCount; ++state) {
+        // Bytes are grouped by target so that each target gets one run of case labels.
+        std::map<int32_t, std::vector<unsigned char>> targets;
+        for (size_t byte = 0; byte < ByteClasses::alphabetSize; ++byte) {
+            const int32_t target = dfa.table[state * stride + dfa.classes[static_cast<unsigned char>(byte)]];
+            if (target != DFA::deadState) {
+                targets[target].push_back(static_cast<unsigned char>(byte));
+            }
+        }
+
+        out << "\nstate" << state << ":\n";
+        out << "    if (position == end) {\n";
+        out << "        return " << (dfa.finalStates[state] ? "true" : "false") << ";\n";
+        out << "    }\n";
+        if (targets.empty()) {
+            out << "    return false;\n";
+            continue;
+        }
+        out << "    switch (*position++) {\n";
+        for (const auto& [target, bytes] : targets) {
+            out << "       ";
+            for (const auto& byte : bytes) {
+                out << " " << caseLabel(byte);
+            }
+            out << "\n            goto state" << target << ";\n";
+        }
+        out << "        default:\n";
+        out << "            return false;\n";
+        out << "    }\n";
+    }
+
+    out << "}\n";
+    return out.str();
+}
+
+std::string CodeGenerator::header(const std::string& function, const std::string& origin) {
+    std::ostringstream out;
+    out << "// Generated by DFA_NFA_codegen from " << origin << ". Do not edit.\n";
+    out << "#pragma once\n\n";
+    out << "#include <string_view>\n\n";
+    out << "bool " << function << "(std::string_view word);\n";
+    return out.str();
+}
+
+void CodeGenerator::write(const DFA& dfa, const std::string& function, const std::string& origin, const std::string& sourceFile, const std::string& headerFile) {
+    const std::pair<const std::string&, std::string> outputs[] = {
+        {sourceFile, source(dfa, function, origin)},
+        {headerFile, header(function, origin)}
+    };
+    for (const auto& [file, text] : outputs) {
+        if (file.empty()) {
+            continue;
+        }
+        std::ofstream f(file, std::ios::binary | std::ios::trunc);
+        if (!f.is_open() || !f.write(text.data(), static_cast<std::streamsize>(text.size()))) {
+            throw std::runtime_error("Could not write generated matcher: " + file);
+        }
+    }
+}
\ No newline at end of file
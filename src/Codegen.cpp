@@ -0,0 +1,27 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <CodeGenerator.h>
+#include <DFA.h>
+#include <NFA.h>
+
+int main(int argc, char* argv[]) {
+    const std::vector<std::string> arguments(argv + 1, argv + argc);
+    if (arguments.size() < 4 || arguments.size() > 5 || (arguments[0] != "dfa" && arguments[0] != "nfa")) {
+        std::cerr << "Usage: DFA_NFA_codegen <dfa|nfa> <config> <function> <output.cpp> [<output.h>]" << std::endl;
+        return 1;
+    }
+
+    try {
+        // NFAs are determinized first; minimizing keeps the emitted switch blocks to one per distinct state.
+        DFA dfa = arguments[0] == "dfa" ? DFA(arguments[1]) : DFA(NFA(arguments[1]));
+        dfa.minimize();
+        CodeGenerator::write(dfa, arguments[2], arguments[1], arguments[3], arguments.size() == 5 ? arguments[4] : "");
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
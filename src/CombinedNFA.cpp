@@ -0,0 +1,105 @@
+#include <algorithm>
+
+#include <CombinedNFA.h>
+#include <Parser.h>
+
+CombinedNFA::CombinedNFA(std::vector<std::string> configs_) : configs(std::move(configs_)) {
+    std::vector<Parser::Transition> transitions;
+    std::vector<uint32_t> starts;
+    std::vector<std::vector<char>> sigmas;
+    for (size_t config = 0; config < configs.size(); ++config) {
+        const Parser parser(configs[config]);
+        const uint32_t start = append(parser, transitions);
+        owners.resize(getStateCount(), static_cast<uint32_t>(config));
+        sigmas.push_back(parser.getSigma());
+        if (start != noState) {
+            starts.push_back(start);
+        }
+    }
+    setTransitions(transitions);
+    compile(starts);
+    findUniversal(sigmas);
+}
+
+void CombinedNFA::compile(const std::vector<uint32_t>& starts) {
+    classes = ByteClasses(edgeOffsets, edgeSymbols, edgeTargets);
+
+    std::vector<uint32_t> closureOffsets, closureTargets;
+    computeClosures(closureOffsets, closureTargets);
+    computeSuccessors(classes, closureOffsets, closureTargets, successorOffsets, successorTargets);
+
+    for (const auto& start : starts) {
+        initialStates.insert(initialStates.end(), closureTargets.begin() + closureOffsets[start], closureTargets.begin() + closureOffsets[start + 1]);
+    }
+    std::sort(initialStates.begin(), initialStates.end());
+    initialStates.erase(std::unique(initialStates.begin(), initialStates.end()), initialStates.end());
+}
+
+// Greatest fixed point: a final state stays universal while every class of its Sigma still has a universal
+// successor. Each row counts its universal successors, and a state losing the property decrements its predecessors.
+void CombinedNFA::findUniversal(const std::vector<std::vector<char>>& sigmas) {
+    sigmaClasses.assign(configs.size(), {});
+    for (size_t config = 0; config < configs.size(); ++config) {
+        for (const auto& symbol : sigmas[config]) {
+            const uint8_t byteClass = classes[static_cast<unsigned char>(symbol)];
+            sigmaClasses[config][byteClass >> 6] |= uint64_t{1} << (byteClass & 63);
+        }
+    }
+
+    const size_t stride = classes.size();
+    const size_t rows = getStateCount() * stride;
+    universal.assign(finals.begin(), finals.end());
+
+    std::vector<uint32_t> support(rows, 0), predecessorOffsets(getStateCount() + 1, 0);
+    for (size_t row = 0; row < rows; ++row) {
+        for (uint32_t i = successorOffsets[row]; i < successorOffsets[row + 1]; ++i) {
+            if (universal[successorTargets[i]]) {
+                ++support[row];
+                ++predecessorOffsets[successorTargets[i] + 1];
+            }
+        }
+    }
+    for (size_t state = 0; state < getStateCount(); ++state) {
+        predecessorOffsets[state + 1] += predecessorOffsets[state];
+    }
+    std::vector<uint32_t> predecessorRows(predecessorOffsets.back());
+    std::vector<uint32_t> fill(predecessorOffsets.begin(), predecessorOffsets.end() - 1);
+    for (size_t row = 0; row < rows; ++row) {
+        for (uint32_t i = successorOffsets[row]; i < successorOffsets[row + 1]; ++i) {
+            if (universal[successorTargets[i]]) {
+                predecessorRows[fill[successorTargets[i]]++] = static_cast<uint32_t>(row);
+            }
+        }
+    }
+
+    const auto needs = [&](const size_t row) {
+        const size_t byteClass = row % stride;
+        return sigmaClasses[owners[row / stride]][byteClass >> 6] >> (byteClass & 63) & 1;
+    };
+
+    std::vector<uint32_t> lost;
+    for (uint32_t state = 0; state < getStateCount(); ++state) {
+        for (size_t row = state * stride; universal[state] && row < (state + 1) * stride; ++row) {
+            if (!support[row] && needs(row)) {
+                universal[state] = 0;
+                lost.push_back(state);
+            }
+        }
+    }
+    while (!lost.empty()) {
+        const uint32_t target = lost.back();
+        lost.pop_back();
+        for (uint32_t i = predecessorOffsets[target]; i < predecessorOffsets[target + 1]; ++i) {
+            const uint32_t row = predecessorRows[i];
+            const auto state = static_cast<uint32_t>(row / stride);
+            if (--support[row] == 0 && universal[state] && needs(row)) {
+                universal[state] = 0;
+                lost.push_back(state);
+            }
+        }
+    }
+}
+
+const std::vector<std::string>& CombinedNFA::getConfigs() const {
+    return configs;
+}
\ No newline at end of file
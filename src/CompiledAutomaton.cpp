@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <CompiledAutomaton.h>
+#include <FiniteAutomaton.h>
+#include <StateSet.h>
+
+namespace {
+    class ImageWriter {
+        std::vector<char> bytes = std::vector<char>(sizeof(CompiledAutomaton::Header), 0);
+
+    public:
+        CompiledAutomaton::Header& header() {
+            return *reinterpret_cast<CompiledAutomaton::Header*>(bytes.data());
+        }
+
+        template <typename T>
+        uint64_t append(const T* data, const size_t count) {
+            bytes.resize((bytes.size() + 7) / 8 * 8, 0);
+            const uint64_t offset = bytes.size();
+            bytes.resize(offset + count * sizeof(T));
+            if (count) {
+                std::memcpy(bytes.data() + offset, data, count * sizeof(T));
+            }
+            return offset;
+        }
+
+        void write(const std::string& file) const {
+            std::ofstream f(file, std::ios::binary | std::ios::trunc);
+            if (!f.is_open() || !f.write(bytes.data(), static_cast<std::streamsize>(bytes.size()))) {
+                throw std::runtime_error("Could not write compiled automaton: " + file);
+            }
+        }
+    };
+
+    std::vector<uint64_t> bitmap(const size_t size, const auto& contains) {
+        std::vector<uint64_t> bits((size + 63) / 64, 0);
+        for (size_t i = 0; i < size; ++i) {
+            if (contains(i)) {
+                bits[i >> 6] |= uint64_t{1} << (i & 63);
+            }
+        }
+        return bits;
+    }
+
+    void writeCommon(ImageWriter& writer, const std::unordered_set<char>& sigma, const std::string& names, const std::vector<uint32_t>& nameOffsets) {
+        std::string symbols(sigma.begin(), sigma.end());
+        std::sort(symbols.begin(), symbols.end());
+
+        auto& header = writer.header();
+        std::memcpy(header.magic, CompiledAutomaton::magic, sizeof(header.magic));
+        header.version = CompiledAutomaton::version;
+        header.byteOrder = CompiledAutomaton::byteOrder;
+        header.stateCount = static_cast<uint32_t>(nameOffsets.size() - 1);
+
+        const uint64_t sigmaOffset = writer.append(symbols.data(), symbols.size());
+        const uint64_t nameOffsetsOffset = writer.append(nameOffsets.data(), nameOffsets.size());
+        const uint64_t namesOffset = writer.append(names.data(), names.size());
+
+        writer.header().sigmaOffset = sigmaOffset;
+        writer.header().sigmaSize = symbols.size();
+        writer.header().nameOffsetsOffset = nameOffsetsOffset;
+        writer.header().namesOffset = namesOffset;
+        writer.header().namesSize = names.size();
+    }
+}
+
+void CompiledAutomaton::save(const DFA& dfa, const std::string& file) {
+    ImageWriter writer;
+    writeCommon(writer, dfa.sigma, dfa.names, dfa.nameOffsets);
+
+    const auto finals = bitmap(dfa.getStateCount(), [&](const size_t state) { return dfa.finalStates[state] != 0; });
+    const uint64_t classMapOffset = writer.append(dfa.classes.data(), ByteClasses::alphabetSize);
+    const uint64_t transitionsOffset = writer.append(dfa.table.data(), dfa.table.size());
+    const uint64_t finalOffset = writer.append(finals.data(), finals.size());
+
+    auto& header = writer.header();
+    header.kind = Kind::DFA;
+    header.classCount = static_cast<uint32_t>(dfa.classes.size());
+    header.start = dfa.start;
+    header.transitionCount = dfa.table.size();
+    header.classMapOffset = classMapOffset;
+    header.transitionsOffset = transitionsOffset;
+    header.finalOffset = finalOffset;
+    writer.write(file);
+}
+
+void CompiledAutomaton::save(const NFA& nfa, const std::string& file) {
+    ImageWriter writer;
+    writeCommon(writer, nfa.sigma, nfa.names, nfa.nameOffsets);
+
+    const auto& transitionOffsets = nfa.successorOffsets;
+    const auto& transitionTargets = nfa.successorTargets;
+
+    const auto finals = bitmap(nfa.getStateCount(), [&](const size_t state) { return nfa.finalStates.contains(state); });
+    const auto initials = bitmap(nfa.getStateCount(), [&](const size_t state) { return nfa.initialStates.contains(state); });
+    const uint64_t classMapOffset = writer.append(nfa.classes.data(), ByteClasses::alphabetSize);
+    const uint64_t transitionsOffset = writer.append(transitionOffsets.data(), transitionOffsets.size());
+    const uint64_t targetsOffset = writer.append(transitionTargets.data(), transitionTargets.size());
+    const uint64_t finalOffset = writer.append(finals.data(), finals.size());
+    const uint64_t initialOffset = writer.append(initials.data(), initials.size());
+
+    auto& header = writer.header();
+    header.kind = Kind::NFA;
+    header.classCount = static_cast<uint32_t>(nfa.classes.size());
+    header.start = -1;
+    header.transitionCount = transitionTargets.size();
+    header.classMapOffset = classMapOffset;
+    header.transitionsOffset = transitionsOffset;
+    header.targetsOffset = targetsOffset;
+    header.finalOffset = finalOffset;
+    header.initialOffset = initialOffset;
+    writer.write(file);
+}
+
+template <typename T>
+const T* CompiledAutomaton::section(const uint64_t offset, const uint64_t count) const {
+    if (offset % alignof(T) || offset > file.size() || count > (file.size() - offset) / sizeof(T)) {
+        throw std::runtime_error("Compiled automaton is truncated or corrupt");
+    }
+    return reinterpret_cast<const T*>(file.data() + offset);
+}
+
+CompiledAutomaton::CompiledAutomaton(const std::string& file_) : file(file_) {
+    header = section<Header>(0, 1);
+    if (std::memcmp(header->magic, magic, sizeof(magic)) != 0 || header->byteOrder != byteOrder) {
+        throw std::runtime_error("Not a compiled automaton: " + file_);
+    }
+    if (header->version != version) {
+        throw std::runtime_error("Unsupported compiled automaton version in " + file_);
+    }
+    if (header->kind != Kind::DFA && header->kind != Kind::NFA) {
+        throw std::runtime_error("Compiled automaton is truncated or corrupt");
+    }
+
+    const uint64_t stateCount = header->stateCount, bitmapSize = (stateCount + 63) / 64;
+    classMap = section<uint8_t>(header->classMapOffset, ByteClasses::alphabetSize);
+    finalStates = section<uint64_t>(header->finalOffset, bitmapSize);
+    nameOffsets = section<uint32_t>(header->nameOffsetsOffset, stateCount + 1);
+    names = section<char>(header->namesOffset, header->namesSize);
+    section<char>(header->sigmaOffset, header->sigmaSize);
+
+    if (header->kind == Kind::DFA) {
+        table = section<int32_t>(header->transitionsOffset, stateCount * header->classCount);
+    } else {
+        offsets = section<uint32_t>(header->transitionsOffset, stateCount * header->classCount + 1);
+        targets = section<uint32_t>(header->targetsOffset, header->transitionCount);
+        initialStates = section<uint64_t>(header->initialOffset, bitmapSize);
+    }
+    validate();
+}
+
+// Matching trusts every index it reads, so an image is checked once here instead of on every symbol.
+void CompiledAutomaton::validate() const {
+    const auto corrupt = [] {
+        throw std::runtime_error("Compiled automaton is truncated or corrupt");
+    };
+
+    const uint32_t stateCount = header->stateCount;
+    const size_t cells = static_cast<size_t>(stateCount) * header->classCount;
+    if (header->classCount == 0 || header->classCount > ByteClasses::alphabetSize) {
+        corrupt();
+    }
+    for (size_t symbol = 0; symbol < ByteClasses::alphabetSize; ++symbol) {
+        if (classMap[symbol] >= header->classCount) {
+            corrupt();
+        }
+    }
+    for (uint32_t state = 0; state < stateCount; ++state) {
+        if (nameOffsets[state] > nameOffsets[state + 1]) {
+            corrupt();
+        }
+    }
+    if (nameOffsets[0] != 0 || nameOffsets[stateCount] > header->namesSize) {
+        corrupt();
+    }
+
+    if (header->kind == Kind::DFA) {
+        if (header->start != DFA::deadState && (header->start < 0 || static_cast<uint32_t>(header->start) >= stateCount)) {
+            corrupt();
+        }
+        for (size_t cell = 0; cell < cells; ++cell) {
+            if (table[cell] != DFA::deadState && (table[cell] < 0 || static_cast<uint32_t>(table[cell]) >= stateCount)) {
+                corrupt();
+            }
+        }
+        return;
+    }
+
+    if (offsets[0] != 0 || offsets[cells] != header->transitionCount) {
+        corrupt();
+    }
+    for (size_t cell = 0; cell < cells; ++cell) {
+        if (offsets[cell] > offsets[cell + 1]) {
+            corrupt();
+        }
+    }
+    for (uint64_t i = 0; i < header->transitionCount; ++i) {
+        if (targets[i] >= stateCount) {
+            corrupt();
+        }
+    }
+    // processNFA copies the initial bitmap wholesale, so padding bits past the last state must be clear.
+    if (stateCount % 64 && initialStates[stateCount / 64] >> (stateCount % 64)) {
+        corrupt();
+    }
+}
+
+bool CompiledAutomaton::isFinal(const uint32_t state) const {
+    return finalStates[state >> 6] >> (state & 63) & 1;
+}
+
+bool CompiledAutomaton::process(const std::string_view word) const {
+    return header->kind == Kind::DFA ? processDFA(word) : processNFA(word);
+}
+
+bool CompiledAutomaton::processDFA(const std::string_view word) const {
+    const size_t stride = header->classCount;
+    int32_t state = header->start;
+    if (state == DFA::deadState) {
+        return false;
+    }
+
+    for (const auto& symbol : word) {
+        state = table[static_cast<size_t>(state) * stride + classMap[static_cast<unsigned char>(symbol)]];
+        if (state == DFA::deadState) {
+            return false;
+        }
+    }
+
+    return isFinal(state);
+}
+
+bool CompiledAutomaton::processNFA(const std::string_view word) const {
+    const size_t stride = header->classCount;
+
+    thread_local StateSet current, next;
+    current.assign(initialStates, header->stateCount);
+    next.resize(header->stateCount);
+
+    for (const auto& symbol : word) {
+        const uint8_t byteClass = classMap[static_cast<unsigned char>(symbol)];
+
+        next.clear();
+        current.forEach([&](const size_t state) {
+            const size_t cell = state * stride + byteClass;
+            for (uint32_t i = offsets[cell]; i < offsets[cell + 1]; ++i) {
+                next.insert(targets[i]);
+            }
+        });
+        std::swap(current, next);
+        if (current.empty()) {
+            return false;
+        }
+    }
+
+    bool accepted = false;
+    current.forEach([&](const size_t state) {
+        accepted = accepted || isFinal(static_cast<uint32_t>(state));
+    });
+    return accepted;
+}
+
+CompiledAutomaton::Kind CompiledAutomaton::getKind() const {
+    return header->kind;
+}
+
+size_t CompiledAutomaton::getStateCount() const {
+    return header->stateCount;
+}
+
+std::string_view CompiledAutomaton::getSigma() const {
+    return {file.data() + header->sigmaOffset, header->sigmaSize};
+}
+
+std::string_view CompiledAutomaton::getStateName(const uint32_t state) const {
+    return {names + nameOffsets[state], nameOffsets[state + 1] - nameOffsets[state]};
+}
\ No newline at end of file
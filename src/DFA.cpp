@@ -1,46 +1,711 @@
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <stdexcept>
+#include <unordered_map>
 
 #include <DFA.h>
 #include <format>
-#include <Setup.h>
+#include <NFA.h>
+#include <Parser.h>
+#include <Profile.h>
+#include <ThreadPool.h>
 #include <UserWarn.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 DFA::DFA(const std::string& file) {
-    const Setup setup(file);
-    setSigma(setup.getSigma());
-    setStates(setup.getStates());
-    setTransitions(setup.getTransitions());
-    setStartState();
+    const auto begin = std::chrono::steady_clock::now();
+    load(Parser(file));
     validate();
+    compile();
+    report = {getStateCount(), getStateCount(), std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin)};
+}
+
+void DFA::validateConfig(const std::string& file) {
+    DFA dfa;
+    dfa.load(Parser(file));
+    dfa.validate();
+}
+
+DFA::DFA(const NFA& nfa, const size_t stateLimit) {
+    const auto begin = std::chrono::steady_clock::now();
+    sigma = nfa.sigma;
+
+    std::vector<std::vector<char>> classSymbols(nfa.classes.size());
+    for (const auto& symbol : sigma) {
+        classSymbols[nfa.classes[static_cast<unsigned char>(symbol)]].push_back(symbol);
+    }
+
+    struct Edge {
+        int32_t from;
+        size_t byteClass;
+        int32_t to;
+    };
+
+    std::vector<StateSet> subsets = {nfa.initialStates};
+    std::unordered_map<StateSet, int32_t> subsetIds = {{nfa.initialStates, 0}};
+    std::vector<Edge> edges;
+    StateSet next(nfa.getStateCount());
+
+    for (size_t i = 0; i < subsets.size(); ++i) {
+        const StateSet current = subsets[i];
+        for (size_t byteClass = 0; byteClass < nfa.classes.size(); ++byteClass) {
+            next.clear();
+            current.forEach([&](const size_t state) {
+                nfa.addSuccessors(state, byteClass, next);
+            });
+            if (next.empty()) {
+                continue;
+            }
+
+            const auto [it, inserted] = subsetIds.try_emplace(next, static_cast<int32_t>(subsets.size()));
+            if (inserted) {
+                if (subsets.size() >= stateLimit) {
+                    throw std::runtime_error(std::format("Subset construction exceeded the limit of {} states", stateLimit));
+                }
+                subsets.push_back(next);
+            }
+            edges.push_back({static_cast<int32_t>(i), byteClass, it->second});
+        }
+    }
+
+    std::string name;
+    for (const auto& subset : subsets) {
+        name.clear();
+        subset.forEach([&](const size_t state) {
+            name += (name.empty() ? '{' : ',');
+            name += nfa.getStateName(state);
+        });
+        name += '}';
+        addState(name, subset.intersects(nfa.finalStates));
+    }
+    startState = 0;
+
+    std::vector<Parser::Transition> transitions;
+    for (const auto& [from, byteClass, to] : edges) {
+        for (const auto& symbol : classSymbols[byteClass]) {
+            transitions.push_back({static_cast<uint32_t>(from), symbol, static_cast<uint32_t>(to)});
+        }
+    }
+    setTransitions(transitions);
+
+    compile();
+    report = {nfa.getStateCount(), getStateCount(), std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin)};
 }
 
 void DFA::validate() {
-    for (const auto& state : states) {
+    for (size_t state = 0; state < getStateCount(); ++state) {
+        if (epsilonOffsets[state] != epsilonOffsets[state + 1]) {
+            UserWarn(std::format("Epsilon transitions are not allowed in a DFA (from {})", getStateName(state)));
+        }
+        const auto first = edgeSymbols.begin() + edgeOffsets[state], last = edgeSymbols.begin() + edgeOffsets[state + 1];
+        if (std::adjacent_find(first, last) == last) {
+            continue;
+        }
         for (const auto& symbol : sigma) {
-            auto transitionsWithSymbol = state->transitions.equal_range(symbol);
-            size_t count = std::distance(transitionsWithSymbol.first, transitionsWithSymbol.second);
-            if (count > 1) {
-                UserWarn(std::format("There are mutliple states leading from {} with symbol {}", state->name, symbol));
+            const auto [low, high] = std::equal_range(first, last, symbol);
+            if (std::distance(low, high) > 1) {
+                UserWarn(std::format("There are mutliple states leading from {} with symbol {}", getStateName(state), symbol));
             }
         }
     }
 }
 
-bool DFA::process(const std::string& word) const {
-    auto currentState = startState;
-    assert(currentState != nullptr);
+void DFA::compile() {
+    classes = ByteClasses(edgeOffsets, edgeSymbols, edgeTargets);
 
-    if (word.empty()) {
-        return currentState->final;
+    const size_t stateCount = getStateCount();
+    table.assign(stateCount * classes.size(), deadState);
+    finalStates.assign(finals.begin(), finals.end());
+
+    for (size_t i = 0; i < stateCount; ++i) {
+        for (uint32_t edge = edgeOffsets[i]; edge < edgeOffsets[i + 1]; ++edge) {
+            table[i * classes.size() + classes[static_cast<unsigned char>(edgeSymbols[edge])]] = static_cast<int32_t>(edgeTargets[edge]);
+        }
     }
 
+    start = startState != noState ? static_cast<int32_t>(startState) : deadState;
+}
+
+void DFA::minimize() {
+    const auto begin = std::chrono::steady_clock::now();
+    const size_t before = getStateCount();
+    const auto record = [&] {
+        report.unminimizedStates = before;
+        report.resultStates = getStateCount();
+        report.minimizeTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    };
+    const auto stateCount = static_cast<int32_t>(before);
+
+    const size_t symbolCount = classes.size();
+
+    std::vector<uint8_t> reachable(stateCount, 0);
+    std::vector<int32_t> queue;
+    if (start != deadState) {
+        reachable[start] = 1;
+        queue.push_back(start);
+    }
+    for (size_t i = 0; i < queue.size(); ++i) {
+        for (size_t symbol = 0; symbol < symbolCount; ++symbol) {
+            const int32_t target = table[queue[i] * symbolCount + symbol];
+            if (target != deadState && !reachable[target]) {
+                reachable[target] = 1;
+                queue.push_back(target);
+            }
+        }
+    }
+
+    std::vector<uint32_t> reverseOffsets(stateCount + 1, 0), reverseSources;
+    for (const auto& state : queue) {
+        for (size_t symbol = 0; symbol < symbolCount; ++symbol) {
+            if (const int32_t target = table[state * symbolCount + symbol]; target != deadState) {
+                ++reverseOffsets[target + 1];
+            }
+        }
+    }
+    for (int32_t i = 0; i < stateCount; ++i) {
+        reverseOffsets[i + 1] += reverseOffsets[i];
+    }
+    reverseSources.resize(reverseOffsets.back());
+    std::vector<uint32_t> fill(reverseOffsets.begin(), reverseOffsets.end() - 1);
+    for (const auto& state : queue) {
+        for (size_t symbol = 0; symbol < symbolCount; ++symbol) {
+            if (const int32_t target = table[state * symbolCount + symbol]; target != deadState) {
+                reverseSources[fill[target]++] = state;
+            }
+        }
+    }
+
+    std::vector<uint8_t> live(stateCount, 0);
+    std::vector<int32_t> liveQueue;
+    for (const auto& state : queue) {
+        if (finalStates[state]) {
+            live[state] = 1;
+            liveQueue.push_back(state);
+        }
+    }
+    for (size_t i = 0; i < liveQueue.size(); ++i) {
+        for (uint32_t j = reverseOffsets[liveQueue[i]]; j < reverseOffsets[liveQueue[i] + 1]; ++j) {
+            if (!live[reverseSources[j]]) {
+                live[reverseSources[j]] = 1;
+                liveQueue.push_back(static_cast<int32_t>(reverseSources[j]));
+            }
+        }
+    }
+
+    if (start == deadState || !live[start]) {
+        const std::vector<int32_t> classOf(stateCount, -1);
+        rebuild(start != deadState ? std::vector<int32_t>{start} : std::vector<int32_t>{}, classOf, start != deadState ? 0 : deadState);
+        record();
+        return;
+    }
+
+    // Dense ids over the useful states, plus one explicit sink so the refinement runs on a complete DFA.
+    std::vector<int32_t> denseId(stateCount, -1), original;
+    for (const auto& state : queue) {
+        if (live[state]) {
+            denseId[state] = static_cast<int32_t>(original.size());
+            original.push_back(state);
+        }
+    }
+    const auto sink = static_cast<int32_t>(original.size());
+    const size_t size = original.size() + 1;
+
+    std::vector<uint32_t> inverseOffsets(symbolCount * size + 1, 0), inverseSources(symbolCount * size);
+    auto targetOf = [&](const int32_t state, const size_t symbol) {
+        if (state == sink) {
+            return sink;
+        }
+        const int32_t target = table[original[state] * symbolCount + symbol];
+        return target == deadState || denseId[target] < 0 ? sink : denseId[target];
+    };
+    for (size_t a = 0; a < symbolCount; ++a) {
+        for (int32_t state = 0; state <= sink; ++state) {
+            ++inverseOffsets[a * size + targetOf(state, a) + 1];
+        }
+    }
+    for (size_t i = 0; i + 1 < inverseOffsets.size(); ++i) {
+        inverseOffsets[i + 1] += inverseOffsets[i];
+    }
+    fill.assign(inverseOffsets.begin(), inverseOffsets.end() - 1);
+    for (size_t a = 0; a < symbolCount; ++a) {
+        for (int32_t state = 0; state <= sink; ++state) {
+            inverseSources[fill[a * size + targetOf(state, a)]++] = state;
+        }
+    }
+
+    std::vector<int32_t> elements(size), location(size), blockOf(size);
+    std::vector<uint32_t> first, end, marked;
+    int32_t position = 0;
+    for (const bool accepting : {true, false}) {
+        first.push_back(position);
+        for (int32_t state = 0; state <= sink; ++state) {
+            if ((state != sink && finalStates[original[state]]) == accepting) {
+                elements[position] = state;
+                location[state] = position++;
+                blockOf[state] = static_cast<int32_t>(first.size()) - 1;
+            }
+        }
+        end.push_back(position);
+        marked.push_back(0);
+    }
+
+    std::vector<std::pair<int32_t, uint32_t>> worklist;
+    std::vector<uint8_t> pending(2 * symbolCount, 0);
+    const int32_t smaller = end[0] - first[0] <= end[1] - first[1] ? 0 : 1;
+    for (uint32_t a = 0; a < symbolCount; ++a) {
+        worklist.emplace_back(smaller, a);
+        pending[smaller * symbolCount + a] = 1;
+    }
+
+    std::vector<int32_t> splitter, touched;
+    while (!worklist.empty()) {
+        const auto [block, a] = worklist.back();
+        worklist.pop_back();
+        pending[block * symbolCount + a] = 0;
+
+        splitter.assign(elements.begin() + first[block], elements.begin() + end[block]);
+        for (const auto& state : splitter) {
+            for (uint32_t j = inverseOffsets[a * size + state]; j < inverseOffsets[a * size + state + 1]; ++j) {
+                const auto predecessor = static_cast<int32_t>(inverseSources[j]);
+                const int32_t predecessorBlock = blockOf[predecessor];
+                const uint32_t target = first[predecessorBlock] + marked[predecessorBlock];
+                if (static_cast<uint32_t>(location[predecessor]) < target) {
+                    continue;
+                }
+                if (marked[predecessorBlock]++ == 0) {
+                    touched.push_back(predecessorBlock);
+                }
+                std::swap(elements[location[predecessor]], elements[target]);
+                location[elements[location[predecessor]]] = location[predecessor];
+                location[predecessor] = static_cast<int32_t>(target);
+            }
+        }
+
+        for (const auto& split : touched) {
+            const uint32_t count = marked[split];
+            marked[split] = 0;
+            if (count == end[split] - first[split]) {
+                continue;
+            }
+
+            const auto created = static_cast<int32_t>(first.size());
+            first.push_back(first[split]);
+            end.push_back(first[split] + count);
+            marked.push_back(0);
+            first[split] += count;
+            pending.resize(pending.size() + symbolCount, 0);
+            for (uint32_t i = first[created]; i < end[created]; ++i) {
+                blockOf[elements[i]] = created;
+            }
+
+            for (uint32_t c = 0; c < symbolCount; ++c) {
+                int32_t added = created;
+                if (!pending[split * symbolCount + c] && end[split] - first[split] < count) {
+                    added = split;
+                }
+                worklist.emplace_back(added, c);
+                pending[added * symbolCount + c] = 1;
+            }
+        }
+        touched.clear();
+    }
+
+    const int32_t sinkBlock = blockOf[sink];
+    std::vector<int32_t> blockClass(first.size(), -1), representatives, classOf(stateCount, -1);
+    for (const auto& state : elements) {
+        if (state == sink || blockOf[state] == sinkBlock) {
+            continue;
+        }
+        if (blockClass[blockOf[state]] < 0) {
+            blockClass[blockOf[state]] = static_cast<int32_t>(representatives.size());
+            representatives.push_back(original[state]);
+        }
+        classOf[original[state]] = blockClass[blockOf[state]];
+    }
+
+    rebuild(representatives, classOf, classOf[start]);
+    record();
+}
+
+void DFA::rebuild(const std::vector<int32_t>& representatives, const std::vector<int32_t>& classOf, const int32_t startClass) {
+    std::string minimalNames;
+    std::vector<uint32_t> minimalOffsets = {0};
+    std::vector<uint8_t> minimalFinals;
+    std::vector<Parser::Transition> transitions;
+
+    for (size_t i = 0; i < representatives.size(); ++i) {
+        minimalNames += getStateName(representatives[i]);
+        minimalOffsets.push_back(static_cast<uint32_t>(minimalNames.size()));
+        minimalFinals.push_back(finals[representatives[i]]);
+        for (const auto& symbol : sigma) {
+            const int32_t target = table[representatives[i] * classes.size() + classes[static_cast<unsigned char>(symbol)]];
+            if (target != deadState && classOf[target] >= 0) {
+                transitions.push_back({static_cast<uint32_t>(i), symbol, static_cast<uint32_t>(classOf[target])});
+            }
+        }
+    }
+
+    names = std::move(minimalNames);
+    nameOffsets = std::move(minimalOffsets);
+    finals = std::move(minimalFinals);
+    startState = startClass != deadState ? static_cast<uint32_t>(startClass) : noState;
+    setTransitions(transitions);
+    compile();
+}
+
+void DFA::setMode(const Mode mode_) {
+    mode = mode_;
+}
+
+DFA::Mode DFA::getMode() const {
+    return mode;
+}
+
+const DFA::BuildReport& DFA::getBuildReport() const {
+    return report;
+}
+
+bool DFA::process(const std::string_view word) const {
+    return mode == Mode::Table ? processTable(word) : processGraph(word);
+}
+
+std::vector<bool> DFA::processBatch(const std::span<const std::string_view> words) const {
+    std::vector<bool> results(words.size());
+
+    // Profiled builds take the per-word path so that every word reaches the counters.
+    if (mode == Mode::Graph || Profile::enabled) {
+        for (size_t i = 0; i < words.size(); ++i) {
+            results[i] = process(words[i]);
+        }
+        return results;
+    }
+
+#if defined(__AVX2__)
+    processGather(words, results);
+#else
+    processLanes(words, results);
+#endif
+    return results;
+}
+
+// Must be called from outside the pool: it blocks on pool.wait() until every chunk is done.
+bool DFA::processParallel(const std::string_view input, ThreadPool& pool) const {
+    if (mode == Mode::Graph || input.size() < parallelThreshold || pool.size() < 2) {
+        return process(input);
+    }
+    assert(start != deadState);
+
+    const size_t chunkCount = pool.size();
+    const size_t chunkSize = (input.size() + chunkCount - 1) / chunkCount;
+    std::vector<std::string_view> chunks;
+    for (size_t begin = 0; begin < input.size(); begin += chunkSize) {
+        chunks.push_back(input.substr(begin, chunkSize));
+    }
+
+    // Enumerating every entry state is exact, but it is only worth it while stepping all of them through the
+    // convergence window costs a small fraction of a chunk; otherwise the entry state is guessed from a lookback window.
+    const bool enumerate = getStateCount() * convergenceWindow <= chunkSize / 8;
+    std::vector<Speculation> speculations(chunks.size());
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        std::vector<int32_t> candidates;
+        if (enumerate) {
+            for (int32_t state = 0; state < static_cast<int32_t>(getStateCount()); ++state) {
+                candidates.push_back(state);
+            }
+        } else {
+            const size_t begin = i * chunkSize;
+            const size_t lookback = std::min(begin, speculationLookback);
+            const int32_t guess = step(start, input.substr(begin - lookback, lookback));
+            candidates = {start};
+            if (guess != deadState && guess != start) {
+                candidates.push_back(guess);
+            }
+        }
+        pool.submit([this, &chunks, &speculations, i, candidates = std::move(candidates)]() mutable {
+            speculations[i] = speculate(chunks[i], std::move(candidates));
+        });
+    }
+    int32_t state = step(start, chunks[0]);
+    pool.wait();
+
+    for (size_t i = 1; i < chunks.size() && state != deadState; ++i) {
+        state = resume(state, chunks[i], speculations[i]);
+    }
+
+    return state != deadState && finalStates[state];
+}
+
+DFA::Speculation DFA::speculate(const std::string_view chunk, std::vector<int32_t> candidates) const {
+    const uint8_t* classMap = classes.data();
+    const size_t stride = classes.size();
+    const int32_t* rows = table.data();
+
+    Speculation speculation;
+    speculation.candidates = candidates;
+
+    // Runs all candidates in lockstep, merging the ones that converge so that each distinct state is stepped once.
+    // Dead candidates stay dead, so only the live ones count: unless they collapse to a single state within the
+    // convergence window, the chunk is abandoned and the stitching pass runs it serially instead.
+    std::vector<int32_t> origin(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        origin[i] = static_cast<int32_t>(i);
+    }
+    std::vector<int32_t>& current = candidates;
+    std::vector<std::pair<int32_t, int32_t>> merge;
+
+    size_t position = 0;
+    for (size_t interval = 0; position < chunk.size(); ++interval) {
+        const size_t end = std::min(chunk.size(), position + mergeInterval);
+        for (auto& state : current) {
+            for (size_t i = position; i < end && state != deadState; ++i) {
+                state = rows[static_cast<size_t>(state) * stride + classMap[static_cast<unsigned char>(chunk[i])]];
+            }
+        }
+        position = end;
+
+        merge.clear();
+        for (size_t i = 0; i < current.size(); ++i) {
+            merge.emplace_back(current[i], static_cast<int32_t>(i));
+        }
+        std::sort(merge.begin(), merge.end());
+
+        std::vector<int32_t> remap(current.size()), distinct;
+        for (size_t i = 0; i < merge.size(); ++i) {
+            if (i == 0 || merge[i].first != merge[i - 1].first) {
+                distinct.push_back(merge[i].first);
+            }
+            remap[merge[i].second] = static_cast<int32_t>(distinct.size()) - 1;
+        }
+        for (auto& index : origin) {
+            index = remap[index];
+        }
+        current = std::move(distinct);
+
+        const size_t live = current.size() - (current[0] == deadState);
+        if (live <= 1) {
+            speculation.converged = interval;
+            break;
+        }
+        if (position >= convergenceWindow || position == chunk.size()) {
+            speculation.abandoned = true;
+            return speculation;
+        }
+    }
+
+    // A single live lane is left: step it alone and remember where it was after every interval.
+    int32_t& lane = current.back();
+    speculation.trail.push_back(lane);
+    while (position < chunk.size()) {
+        const size_t end = std::min(chunk.size(), position + mergeInterval);
+        for (size_t i = position; i < end && lane != deadState; ++i) {
+            lane = rows[static_cast<size_t>(lane) * stride + classMap[static_cast<unsigned char>(chunk[i])]];
+        }
+        position = end;
+        speculation.trail.push_back(lane);
+    }
+
+    speculation.outcomes.resize(origin.size());
+    for (size_t i = 0; i < origin.size(); ++i) {
+        speculation.outcomes[i] = current[origin[i]];
+    }
+    return speculation;
+}
+
+int32_t DFA::resume(int32_t state, const std::string_view chunk, const Speculation& speculation) const {
+    if (speculation.abandoned) {
+        return step(state, chunk);
+    }
+    const auto guessed = std::find(speculation.candidates.begin(), speculation.candidates.end(), state);
+    if (guessed != speculation.candidates.end()) {
+        return speculation.outcomes[guessed - speculation.candidates.begin()];
+    }
+
+    // A missed guess only has to be run until it meets the converged lane; from there on the two are identical.
+    for (size_t interval = 0, position = 0; position < chunk.size() && state != deadState; ++interval) {
+        const size_t end = std::min(chunk.size(), position + mergeInterval);
+        state = step(state, chunk.substr(position, end - position));
+        position = end;
+        if (interval >= speculation.converged && state == speculation.trail[interval - speculation.converged]) {
+            return speculation.trail.back();
+        }
+    }
+    return state;
+}
+
+void DFA::processLanes(const std::span<const std::string_view> words, std::vector<bool>& results) const {
+    assert(start != deadState);
+
+    const uint8_t* classMap = classes.data();
+    const size_t stride = classes.size();
+    const int32_t* rows = table.data();
+
+    std::array<const unsigned char*, batchLanes> position{}, end{};
+    std::array<int32_t, batchLanes> state{};
+    std::array<size_t, batchLanes> word{};
+    size_t nextWord = 0, active = 0;
+
+    auto load = [&](const size_t lane) {
+        if (nextWord == words.size()) {
+            position[lane] = end[lane] = nullptr;
+            return false;
+        }
+        word[lane] = nextWord;
+        position[lane] = reinterpret_cast<const unsigned char*>(words[nextWord].data());
+        end[lane] = position[lane] + words[nextWord].size();
+        state[lane] = start;
+        ++nextWord;
+        return true;
+    };
+
+    for (size_t lane = 0; lane < batchLanes; ++lane) {
+        active += load(lane);
+    }
+
+    while (active) {
+        for (size_t lane = 0; lane < batchLanes; ++lane) {
+            if (!position[lane]) {
+                continue;
+            }
+            if (position[lane] != end[lane]) {
+                state[lane] = rows[static_cast<size_t>(state[lane]) * stride + classMap[*position[lane]++]];
+                if (state[lane] != deadState) {
+                    continue;
+                }
+            }
+            results[word[lane]] = state[lane] != deadState && finalStates[state[lane]];
+            active -= !load(lane);
+        }
+    }
+}
+
+#if defined(__AVX2__)
+void DFA::processGather(const std::span<const std::string_view> words, std::vector<bool>& results) const {
+    static_assert(batchLanes == 8, "one AVX2 register holds eight 32-bit lanes");
+    assert(start != deadState);
+    assert(table.size() <= static_cast<size_t>(INT32_MAX));
+
+    const uint8_t* classMap = classes.data();
+    const auto stride = static_cast<int32_t>(classes.size());
+    const int32_t* rows = table.data();
+
+    alignas(32) std::array<int32_t, batchLanes> state{}, byteClass{}, live{};
+    std::array<const unsigned char*, batchLanes> position{}, end{};
+    std::array<size_t, batchLanes> word{};
+    size_t nextWord = 0, active = 0;
+
+    auto load = [&](const size_t lane) {
+        if (nextWord == words.size()) {
+            position[lane] = end[lane] = nullptr;
+            live[lane] = 0;
+            return false;
+        }
+        word[lane] = nextWord;
+        position[lane] = reinterpret_cast<const unsigned char*>(words[nextWord].data());
+        end[lane] = position[lane] + words[nextWord].size();
+        state[lane] = start;
+        live[lane] = -1;
+        ++nextWord;
+        return true;
+    };
+
+    auto retire = [&](const size_t lane) {
+        results[word[lane]] = state[lane] != deadState && finalStates[state[lane]];
+        return load(lane);
+    };
+
+    for (size_t lane = 0; lane < batchLanes; ++lane) {
+        active += load(lane);
+    }
+
+    const __m256i strides = _mm256_set1_epi32(stride);
+    while (active) {
+        for (size_t lane = 0; lane < batchLanes; ++lane) {
+            while (position[lane] && position[lane] == end[lane]) {
+                active -= !retire(lane);
+            }
+            byteClass[lane] = position[lane] ? classMap[*position[lane]++] : 0;
+        }
+        if (!active) {
+            break;
+        }
+
+        const __m256i current = _mm256_load_si256(reinterpret_cast<const __m256i*>(state.data()));
+        const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(live.data()));
+        const __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(current, strides), _mm256_load_si256(reinterpret_cast<const __m256i*>(byteClass.data())));
+        const __m256i next = _mm256_mask_i32gather_epi32(current, rows, index, mask, sizeof(int32_t));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(state.data()), next);
+
+        for (size_t lane = 0; lane < batchLanes; ++lane) {
+            if (position[lane] && state[lane] == deadState) {
+                active -= !retire(lane);
+            }
+        }
+    }
+}
+#endif
+
+bool DFA::processTable(const std::string_view word) const {
+    assert(start != deadState);
+
+    const uint8_t* classMap = classes.data();
+    const size_t stride = classes.size();
+    const int32_t* rows = table.data();
+    DFA_NFA_PROFILE_SCOPE(this);
+
+    int32_t state = start;
+    for (size_t i = 0; i < word.size(); ++i) {
+        DFA_NFA_PROFILE_TRANSITION(state, word[i]);
+        state = rows[static_cast<size_t>(state) * stride + classMap[static_cast<unsigned char>(word[i])]];
+        if (state == deadState) {
+            DFA_NFA_PROFILE_RESULT(false, i);
+            return false;
+        }
+    }
+
+    DFA_NFA_PROFILE_VISIT(state);
+    DFA_NFA_PROFILE_RESULT(finalStates[state], word.size());
+    return finalStates[state];
+}
+
+int32_t DFA::step(int32_t state, const std::string_view chunk) const {
+    const uint8_t* classMap = classes.data();
+    const size_t stride = classes.size();
+    const int32_t* rows = table.data();
+
+    for (const auto& symbol : chunk) {
+        state = rows[static_cast<size_t>(state) * stride + classMap[static_cast<unsigned char>(symbol)]];
+        if (state == deadState) {
+            return deadState;
+        }
+    }
+
+    return state;
+}
+
+int32_t DFA::getStart() const {
+    return start;
+}
+
+bool DFA::isFinal(const int32_t state) const {
+    return finalStates[state];
+}
+
+bool DFA::processGraph(const std::string_view word) const {
+    uint32_t currentState = startState;
+    assert(currentState != noState);
+
     for (const auto &symbol : word) {
-        auto transitionsWithSymbol = currentState->transitions.equal_range(symbol);
-        if (transitionsWithSymbol.first == transitionsWithSymbol.second) {
+        const auto first = edgeSymbols.begin() + edgeOffsets[currentState], last = edgeSymbols.begin() + edgeOffsets[currentState + 1];
+        const auto edge = std::lower_bound(first, last, symbol);
+        if (edge == last || *edge != symbol) {
             return false;
         }
-        currentState = transitionsWithSymbol.first->second;
+        currentState = edgeTargets[edge - edgeSymbols.begin()];
     }
 
-    return currentState->final;
+    return finals[currentState];
 }
\ No newline at end of file
@@ -1,98 +1,158 @@
-#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
 
 #include <FiniteAutomaton.h>
-#include <State.h>
-#include <UserWarn.h>
 
-bool FiniteAutomaton::inSigma(const char& symbol){
-    return !(this->sigma.find(symbol) == this->sigma.end());
+void FiniteAutomaton::load(const Parser& parser) {
+    std::vector<Parser::Transition> transitions;
+    this->startState = append(parser, transitions);
+    setTransitions(transitions);
 }
 
-void FiniteAutomaton::setSigma(std::vector<std::string> const& sigma_) {
-     for (const auto& line : sigma_) {
-         this->sigma.insert(line[0]);
-     }
+uint32_t FiniteAutomaton::append(const Parser& parser, std::vector<Parser::Transition>& transitions) {
+    for (const auto& symbol : parser.getSigma()) {
+        this->sigma.insert(symbol);
+    }
+
+    // Parser ids follow first mention; states are numbered in declaration order instead.
+    std::vector<uint32_t> byId(parser.getStateCount());
+    uint32_t start = noState;
+    this->finals.reserve(this->finals.size() + parser.getDeclarations().size());
+    this->nameOffsets.reserve(this->nameOffsets.size() + parser.getDeclarations().size());
+
+    for (const auto& id : parser.getDeclarations()) {
+        byId[id] = addState(parser.getName(id), parser.isFinal(id));
+        if (parser.isInitial(id)) {
+            start = byId[id];
+        }
+    }
+
+    transitions.reserve(transitions.size() + parser.getTransitions().size());
+    for (const auto& [from, symbol, to, epsilon] : parser.getTransitions()) {
+        transitions.push_back({byId[from], symbol, byId[to], epsilon});
+    }
+    return start;
 }
 
-void FiniteAutomaton::setStates(const std::vector<std::string>& stateLines) {
-     bool hasInitialState = false, hasFinalState = false;
-     for (const auto& line : stateLines) {
-         auto newState = std::make_shared<State>();
-
-         std::istringstream iss(line);
-         std::string token;
-
-         while (std::getline(iss, token, ',')) {
-             token.erase(0, token.find_first_not_of(' '));
-             token.erase(token.find_last_not_of(' ') + 1);
-
-             if (token == "S") {
-                 if (hasInitialState) {
-                     UserWarn("Initial state should be unique", line);
-                 }
-                 hasInitialState = true;
-                 newState->initial = true;
-             } else if (token == "F") {
-                 newState->final = true;
-                 hasFinalState = true;
-             } else {
-                 newState->name = token;
-             }
-         }
-
-         if (newState->name.empty()) {
-             UserWarn("State must have a name", line);
-             continue;
-         }
-
-         this->stateMap[newState->name] = newState;
-         this->states.push_back(newState);
-     }
-
-    if (this->states.empty()) {
-        UserWarn("There are no states declared for this DFA");
+uint32_t FiniteAutomaton::addState(const std::string_view name, const bool final) {
+    this->names += name;
+    this->nameOffsets.push_back(static_cast<uint32_t>(this->names.size()));
+    this->finals.push_back(final);
+    return static_cast<uint32_t>(this->finals.size() - 1);
+}
+
+void FiniteAutomaton::setTransitions(const std::span<const Parser::Transition> transitions) {
+    const size_t stateCount = getStateCount();
+    edgeOffsets.assign(stateCount + 1, 0);
+    epsilonOffsets.assign(stateCount + 1, 0);
+    for (const auto& transition : transitions) {
+        ++(transition.epsilon ? epsilonOffsets : edgeOffsets)[transition.from + 1];
+    }
+    for (size_t i = 0; i < stateCount; ++i) {
+        edgeOffsets[i + 1] += edgeOffsets[i];
+        epsilonOffsets[i + 1] += epsilonOffsets[i];
     }
 
-     if (!hasFinalState) {
-         UserWarn("At least one final state required");
-     }
- }
-
- void FiniteAutomaton::setTransitions(std::vector<std::string> const& transitions) {
-     for (const auto& line : transitions) {
-         std::istringstream iss(line);
-         std::string fromState, toState, token;
-         char symbol;
-
-         int tokenCount = 0;
-         while (std::getline(iss, token, ',')) {
-             token.erase(0, token.find_first_not_of(' '));
-             token.erase(token.find_last_not_of(' ') + 1);
-             switch (tokenCount++) {
-                 case 0: fromState = token; break;
-                 case 1: if (token.length() > 1) UserWarn("The symbol should be an unique character", line); symbol = token[0]; break;
-                 case 2: toState = token; break;
-                 default: break;
-             }
-         }
-
-         if (!inSigma(symbol)){
-             UserWarn("The symbol is not defined in Sigma");
-         }
-
-         if (this->stateMap.contains(fromState) && this->stateMap.contains(toState)) {
-             this->stateMap[fromState]->transitions.insert({symbol, this->stateMap[toState]});
-         } else {
-             UserWarn("There are undefined states", line);
-         }
-     }
- }
-
-void FiniteAutomaton::setStartState() {
-    for (const auto & state : states) {
-        if (state->initial) {
-            startState = state;
-            break;
+    edgeSymbols.resize(edgeOffsets.back());
+    edgeTargets.resize(edgeOffsets.back());
+    epsilonTargets.resize(epsilonOffsets.back());
+    std::vector<uint32_t> edgeFill(edgeOffsets.begin(), edgeOffsets.end() - 1);
+    std::vector<uint32_t> epsilonFill(epsilonOffsets.begin(), epsilonOffsets.end() - 1);
+    for (const auto& [from, symbol, to, epsilon] : transitions) {
+        if (epsilon) {
+            epsilonTargets[epsilonFill[from]++] = to;
+        } else {
+            edgeSymbols[edgeFill[from]] = symbol;
+            edgeTargets[edgeFill[from]++] = to;
+        }
+    }
+
+    // Engines binary-search a state's edges by symbol; most inputs already list them in order.
+    std::vector<std::pair<char, uint32_t>> edges;
+    for (size_t state = 0; state < stateCount; ++state) {
+        const uint32_t first = edgeOffsets[state], last = edgeOffsets[state + 1];
+        if (std::is_sorted(edgeSymbols.begin() + first, edgeSymbols.begin() + last)) {
+            continue;
+        }
+        edges.clear();
+        for (uint32_t edge = first; edge < last; ++edge) {
+            edges.emplace_back(edgeSymbols[edge], edgeTargets[edge]);
+        }
+        std::stable_sort(edges.begin(), edges.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (uint32_t edge = first; edge < last; ++edge) {
+            std::tie(edgeSymbols[edge], edgeTargets[edge]) = edges[edge - first];
         }
     }
+}
+
+void FiniteAutomaton::computeClosures(std::vector<uint32_t>& closureOffsets, std::vector<uint32_t>& closureTargets) const {
+    const size_t stateCount = getStateCount();
+    closureOffsets.assign(1, 0);
+    closureOffsets.reserve(stateCount + 1);
+    closureTargets.clear();
+
+    std::vector<uint32_t> stack, reachedBy(stateCount, noState);
+    for (uint32_t i = 0; i < stateCount; ++i) {
+        reachedBy[i] = i;
+        closureTargets.push_back(i);
+        stack.push_back(i);
+        while (!stack.empty()) {
+            const uint32_t state = stack.back();
+            stack.pop_back();
+            for (uint32_t edge = epsilonOffsets[state]; edge < epsilonOffsets[state + 1]; ++edge) {
+                const uint32_t target = epsilonTargets[edge];
+                if (reachedBy[target] != i) {
+                    reachedBy[target] = i;
+                    closureTargets.push_back(target);
+                    stack.push_back(target);
+                }
+            }
+        }
+        std::sort(closureTargets.begin() + closureOffsets.back(), closureTargets.end());
+        if (closureTargets.size() > UINT32_MAX) {
+            throw std::runtime_error("Too many NFA states in epsilon-closures");
+        }
+        closureOffsets.push_back(static_cast<uint32_t>(closureTargets.size()));
+    }
+}
+
+void FiniteAutomaton::computeSuccessors(const ByteClasses& classes, const std::vector<uint32_t>& closureOffsets, const std::vector<uint32_t>& closureTargets,
+                                        std::vector<uint32_t>& successorOffsets, std::vector<uint32_t>& successorTargets) const {
+    const size_t stateCount = getStateCount();
+    successorOffsets.assign(1, 0);
+    successorOffsets.reserve(stateCount * classes.size() + 1);
+    successorTargets.clear();
+
+    std::vector<std::pair<uint8_t, uint32_t>> successors;
+    for (size_t state = 0; state < stateCount; ++state) {
+        successors.clear();
+        for (uint32_t edge = edgeOffsets[state]; edge < edgeOffsets[state + 1]; ++edge) {
+            const uint8_t byteClass = classes[static_cast<unsigned char>(edgeSymbols[edge])];
+            const uint32_t target = edgeTargets[edge];
+            for (uint32_t i = closureOffsets[target]; i < closureOffsets[target + 1]; ++i) {
+                successors.emplace_back(byteClass, closureTargets[i]);
+            }
+        }
+        std::sort(successors.begin(), successors.end());
+        successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+        auto next = successors.begin();
+        for (size_t byteClass = 0; byteClass < classes.size(); ++byteClass) {
+            for (; next != successors.end() && next->first == byteClass; ++next) {
+                successorTargets.push_back(next->second);
+            }
+            if (successorTargets.size() > UINT32_MAX) {
+                throw std::runtime_error("Too many NFA transitions after epsilon-closure");
+            }
+            successorOffsets.push_back(static_cast<uint32_t>(successorTargets.size()));
+        }
+    }
+}
+
+size_t FiniteAutomaton::getStateCount() const {
+    return finals.size();
+}
+
+std::string_view FiniteAutomaton::getStateName(const size_t index) const {
+    return std::string_view(names).substr(nameOffsets[index], nameOffsets[index + 1] - nameOffsets[index]);
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Generator.h>
+
+static int usage() {
+    std::cerr << "Usage: DFA_NFA_generate <config> [--states=N] [--alphabet=N] [--out-degree=N] [--nondeterminism=X] [--final-density=X] [--seed=N]" << std::endl
+              << "                        [--corpus=<words> --count=N --min-length=N --max-length=N --accept-ratio=X]" << std::endl;
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    const std::vector<std::string> arguments(argv + 1, argv + argc);
+    if (arguments.empty() || arguments[0].starts_with("--")) {
+        return usage();
+    }
+
+    Generator::Parameters parameters;
+    std::string corpus;
+    size_t count = 1000, minLength = 1, maxLength = 16;
+    double acceptRatio = 0.5;
+    try {
+        for (size_t i = 1; i < arguments.size(); ++i) {
+            const size_t equals = arguments[i].find('=');
+            const std::string key = arguments[i].substr(0, equals);
+            const std::string value = equals == std::string::npos ? "" : arguments[i].substr(equals + 1);
+            if (key == "--states") {
+                parameters.states = std::stoull(value);
+            } else if (key == "--alphabet") {
+                parameters.alphabet = std::stoull(value);
+            } else if (key == "--out-degree") {
+                parameters.outDegree = std::stoull(value);
+            } else if (key == "--nondeterminism") {
+                parameters.nondeterminism = std::stod(value);
+            } else if (key == "--final-density") {
+                parameters.finalDensity = std::stod(value);
+            } else if (key == "--seed") {
+                parameters.seed = std::stoull(value);
+            } else if (key == "--corpus") {
+                corpus = value;
+            } else if (key == "--count") {
+                count = std::stoull(value);
+            } else if (key == "--min-length") {
+                minLength = std::stoull(value);
+            } else if (key == "--max-length") {
+                maxLength = std::stoull(value);
+            } else if (key == "--accept-ratio") {
+                acceptRatio = std::stod(value);
+            } else {
+                return usage();
+            }
+        }
+    } catch (const std::logic_error&) {
+        return usage();
+    }
+
+    try {
+        const auto begin = std::chrono::steady_clock::now();
+        const Generator generator(parameters);
+        generator.writeConfig(arguments[0]);
+        if (!corpus.empty()) {
+            generator.writeCorpus(corpus, count, minLength, maxLength, acceptRatio);
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        std::cerr << "Generated " << (generator.isDeterministic() ? "DFA" : "NFA") << " with " << parameters.states << " states and "
+                  << generator.getTransitionCount() << " transitions in " << elapsed.count() << "s" << std::endl;
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
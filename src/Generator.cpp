@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+#include <Generator.h>
+
+namespace {
+    class BufferedWriter {
+        static constexpr size_t capacity = 1 << 20;
+
+        std::ofstream file;
+        std::string buffer;
+        std::string path;
+
+    public:
+        explicit BufferedWriter(const std::string& path_) : file(path_, std::ios::binary | std::ios::trunc), path(path_) {
+            if (!file.is_open()) {
+                throw std::runtime_error("Could not write generated file: " + path);
+            }
+            buffer.reserve(capacity + 64);
+        }
+
+        void put(const std::string_view text) {
+            buffer += text;
+        }
+
+        void put(const char symbol) {
+            buffer += symbol;
+        }
+
+        void putNumber(const uint64_t value) {
+            char digits[20];
+            const auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+            buffer.append(digits, end);
+        }
+
+        // Flushing only between records keeps each write a single large block.
+        void endRecord() {
+            buffer += '\n';
+            if (buffer.size() >= capacity) {
+                flush();
+            }
+        }
+
+        void flush() {
+            if (!file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+                throw std::runtime_error("Could not write generated file: " + path);
+            }
+            buffer.clear();
+        }
+    };
+}
+
+Generator::Generator(const Parameters& parameters_) : parameters(parameters_), rng(parameters_.seed) {
+    if (parameters.states == 0 || parameters.states > UINT32_MAX) {
+        throw std::runtime_error("Generated automata need between 1 and 2^32 - 1 states");
+    }
+    parameters.alphabet = std::clamp<size_t>(parameters.alphabet, 1, symbols.size());
+    parameters.outDegree = std::min(parameters.outDegree, parameters.alphabet);
+    parameters.nondeterminism = std::max(parameters.nondeterminism, 1.0);
+    parameters.finalDensity = std::clamp(parameters.finalDensity, 0.0, 1.0);
+
+    const size_t states = parameters.states;
+    const double expected = static_cast<double>(states * parameters.outDegree) * parameters.nondeterminism;
+    if (expected >= static_cast<double>(UINT32_MAX)) {
+        throw std::runtime_error("Generated automata need fewer than 2^32 transitions");
+    }
+
+    const size_t baseTargets = static_cast<size_t>(std::floor(parameters.nondeterminism));
+    std::bernoulli_distribution extraTarget(parameters.nondeterminism - static_cast<double>(baseTargets));
+    std::bernoulli_distribution isFinal(parameters.finalDensity);
+    std::string alphabet(symbols.substr(0, parameters.alphabet));
+
+    offsets.reserve(states + 1);
+    offsets.push_back(0);
+    edgeSymbols.reserve(static_cast<size_t>(expected * 1.05));
+    targets.reserve(static_cast<size_t>(expected * 1.05));
+    finalStates.resize(states);
+
+    for (size_t state = 0; state < states; ++state) {
+        finalStates[state] = isFinal(rng);
+
+        // A partial shuffle picks the outDegree distinct symbols that leave this state.
+        for (size_t i = 0; i < parameters.outDegree; ++i) {
+            std::swap(alphabet[i], alphabet[i + rng() % (alphabet.size() - i)]);
+
+            const size_t pairBegin = targets.size();
+            const size_t count = baseTargets + extraTarget(rng);
+            for (size_t k = 0; k < count; ++k) {
+                const auto target = static_cast<uint32_t>(rng() % states);
+                if (std::find(targets.begin() + static_cast<std::ptrdiff_t>(pairBegin), targets.end(), target) == targets.end()) {
+                    edgeSymbols.push_back(alphabet[i]);
+                    targets.push_back(target);
+                }
+            }
+        }
+        offsets.push_back(static_cast<uint32_t>(targets.size()));
+    }
+
+    // Parser rejects a configuration without a final state, which small or sparse draws can produce.
+    if (std::find(finalStates.begin(), finalStates.end(), 1) == finalStates.end()) {
+        finalStates[rng() % states] = 1;
+    }
+}
+
+size_t Generator::getTransitionCount() const {
+    return targets.size();
+}
+
+bool Generator::isDeterministic() const {
+    return parameters.nondeterminism == 1.0;
+}
+
+bool Generator::accepts(const std::string_view word) const {
+    stamps.resize(parameters.states, 0);
+    std::vector<uint32_t> current{0}, next;
+    for (const char symbol : word) {
+        if (++stamp == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            stamp = 1;
+        }
+        next.clear();
+        for (const uint32_t state : current) {
+            for (uint32_t edge = offsets[state]; edge < offsets[state + 1]; ++edge) {
+                if (edgeSymbols[edge] == symbol && stamps[targets[edge]] != stamp) {
+                    stamps[targets[edge]] = stamp;
+                    next.push_back(targets[edge]);
+                }
+            }
+        }
+        std::swap(current, next);
+        if (current.empty()) {
+            return false;
+        }
+    }
+    return std::any_of(current.begin(), current.end(), [this](const uint32_t state) {
+        return finalStates[state];
+    });
+}
+
+// A random path that ends in a final state spells an accepted word, for NFAs as well as DFAs.
+bool Generator::walk(const size_t length, std::string& word) const {
+    word.clear();
+    uint32_t state = 0;
+    for (size_t i = 0; i < length; ++i) {
+        const uint32_t degree = offsets[state + 1] - offsets[state];
+        if (degree == 0) {
+            return false;
+        }
+        const uint32_t edge = offsets[state] + static_cast<uint32_t>(rng() % degree);
+        word += edgeSymbols[edge];
+        state = targets[edge];
+    }
+    return finalStates[state];
+}
+
+bool Generator::scatter(const size_t length, std::string& word) const {
+    word.resize(length);
+    for (auto& symbol : word) {
+        symbol = symbols[rng() % parameters.alphabet];
+    }
+    return !accepts(word);
+}
+
+std::vector<std::string> Generator::corpus(const size_t count, const size_t minLength, const size_t maxLength, const double acceptRatio) const {
+    constexpr size_t attempts = 1000;
+
+    const auto acceptedCount = static_cast<size_t>(std::llround(static_cast<double>(count) * std::clamp(acceptRatio, 0.0, 1.0)));
+    std::vector<uint8_t> plan(count, 0);
+    std::fill(plan.begin(), plan.begin() + static_cast<std::ptrdiff_t>(acceptedCount), 1);
+    std::shuffle(plan.begin(), plan.end(), rng);
+
+    std::uniform_int_distribution<size_t> lengths(minLength, std::max(minLength, maxLength));
+    std::vector<std::string> words(count);
+    for (size_t i = 0; i < count; ++i) {
+        bool generated = false;
+        for (size_t attempt = 0; attempt < attempts && !generated; ++attempt) {
+            generated = plan[i] ? walk(lengths(rng), words[i]) : scatter(lengths(rng), words[i]);
+        }
+        if (!generated) {
+            throw std::runtime_error(plan[i] ? "Could not generate an accepted word in the requested length range"
+                                             : "Could not generate a rejected word in the requested length range");
+        }
+    }
+    return words;
+}
+
+void Generator::writeConfig(const std::string& file) const {
+    BufferedWriter out(file);
+    out.put("Sigma:");
+    out.endRecord();
+    for (size_t i = 0; i < parameters.alphabet; ++i) {
+        out.put(symbols[i]);
+        out.endRecord();
+    }
+    out.put("End");
+    out.endRecord();
+
+    out.put("States:");
+    out.endRecord();
+    for (size_t state = 0; state < parameters.states; ++state) {
+        out.put('q');
+        out.putNumber(state);
+        out.put(state == 0 ? ", S" : "");
+        out.put(finalStates[state] ? ", F" : "");
+        out.endRecord();
+    }
+    out.put("End");
+    out.endRecord();
+
+    out.put("Transitions:");
+    out.endRecord();
+    for (size_t state = 0; state < parameters.states; ++state) {
+        for (uint32_t edge = offsets[state]; edge < offsets[state + 1]; ++edge) {
+            out.put('q');
+            out.putNumber(state);
+            out.put(", ");
+            out.put(edgeSymbols[edge]);
+            out.put(", q");
+            out.putNumber(targets[edge]);
+            out.endRecord();
+        }
+    }
+    out.put("End");
+    out.endRecord();
+    out.flush();
+}
+
+void Generator::writeCorpus(const std::string& file, const size_t count, const size_t minLength, const size_t maxLength, const double acceptRatio) const {
+    BufferedWriter out(file);
+    for (const auto& word : corpus(count, minLength, maxLength, acceptRatio)) {
+        out.put(word);
+        out.endRecord();
+    }
+    out.flush();
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include <cassert>
+
+#include <LazyDFA.h>
+
+LazyDFA::LazyDFA(const NFA& nfa_, const size_t memoryBudget_, const size_t flushLimit_)
+    : nfa(nfa_), memoryBudget(memoryBudget_), flushLimit(flushLimit_), scratch(nfa_.getStateCount()) {
+    const size_t setBytes = (nfa.getStateCount() + 63) / 64 * sizeof(uint64_t);
+    stateBytes = 2 * setBytes + nfa.classes.size() * sizeof(int32_t) + 4 * sizeof(void*);
+    flush();
+}
+
+void LazyDFA::flush() {
+    subsets.clear();
+    subsetIds.clear();
+    table.clear();
+    finalStates.clear();
+    addState(nfa.initialStates);
+}
+
+int32_t LazyDFA::addState(const StateSet& subset) {
+    const auto id = static_cast<int32_t>(subsets.size());
+    subsets.push_back(subset);
+    subsetIds.emplace(subset, id);
+    table.resize(table.size() + nfa.classes.size(), unknownState);
+    finalStates.push_back(subset.intersects(nfa.finalStates));
+    return id;
+}
+
+int32_t LazyDFA::transition(const int32_t state, const uint8_t byteClass, size_t& flushes) {
+    ++counters.misses;
+
+    scratch.clear();
+    subsets[state].forEach([&](const size_t nfaState) {
+        nfa.addSuccessors(nfaState, byteClass, scratch);
+    });
+    if (scratch.empty()) {
+        table[state * nfa.classes.size() + byteClass] = deadState;
+        return deadState;
+    }
+
+    if (const auto it = subsetIds.find(scratch); it != subsetIds.end()) {
+        table[state * nfa.classes.size() + byteClass] = it->second;
+        return it->second;
+    }
+
+    if ((subsets.size() + 1) * stateBytes > memoryBudget) {
+        ++counters.flushes;
+        ++flushes;
+        flush();
+        return addState(scratch);
+    }
+
+    const int32_t next = addState(scratch);
+    table[state * nfa.classes.size() + byteClass] = next;
+    return next;
+}
+
+bool LazyDFA::process(const std::string_view word) {
+    assert(!nfa.initialStates.empty());
+
+    int32_t state = 0;
+    size_t flushes = 0;
+
+    for (size_t position = 0; position < word.size(); ++position) {
+        const uint8_t byteClass = nfa.classes[static_cast<unsigned char>(word[position])];
+        const int32_t next = table[state * nfa.classes.size() + byteClass];
+        if (next != unknownState) {
+            ++counters.hits;
+            state = next;
+        } else {
+            state = transition(state, byteClass, flushes);
+            if (state != deadState && flushes > flushLimit) {
+                ++counters.fallbacks;
+                return simulate(subsets[state], word, position + 1);
+            }
+        }
+
+        if (state == deadState) {
+            return false;
+        }
+    }
+
+    return finalStates[state];
+}
+
+bool LazyDFA::simulate(const StateSet& from, const std::string_view word, const size_t position) const {
+    StateSet current = from, next(current.size());
+    return nfa.step(current, next, word.substr(position)) && nfa.accepts(current);
+}
+
+const LazyDFA::Counters& LazyDFA::getCounters() const {
+    return counters;
+}
+
+size_t LazyDFA::getCachedStates() const {
+    return subsets.size();
+}
+
+void LazyDFA::resetCounters() {
+    counters = {};
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include <stdexcept>
+#include <utility>
+
+#include <MappedFile.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& file) {
+#if defined(_WIN32)
+    HANDLE handle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Provided file does not exist: " + file);
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(handle, &fileSize);
+    length = static_cast<size_t>(fileSize.QuadPart);
+    if (length) {
+        mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        begin = mapping ? static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+    }
+    CloseHandle(handle);
+#else
+    const int descriptor = open(file.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("Provided file does not exist: " + file);
+    }
+    struct stat status{};
+    fstat(descriptor, &status);
+    length = static_cast<size_t>(status.st_size);
+    if (length) {
+        void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        begin = address == MAP_FAILED ? nullptr : static_cast<const char*>(address);
+        if (begin) {
+            madvise(address, length, MADV_SEQUENTIAL);
+        }
+    }
+    close(descriptor);
+#endif
+    if (length && !begin) {
+        throw std::runtime_error("Could not map file: " + file);
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : begin(std::exchange(other.begin, nullptr)), length(std::exchange(other.length, 0)) {
+#if defined(_WIN32)
+    mapping = std::exchange(other.mapping, nullptr);
+#endif
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        begin = std::exchange(other.begin, nullptr);
+        length = std::exchange(other.length, 0);
+#if defined(_WIN32)
+        mapping = std::exchange(other.mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+#if defined(_WIN32)
+    if (begin) {
+        UnmapViewOfFile(begin);
+    }
+    if (mapping) {
+        CloseHandle(mapping);
+    }
+    mapping = nullptr;
+#else
+    if (begin) {
+        munmap(const_cast<char*>(begin), length);
+    }
+#endif
+    begin = nullptr;
+    length = 0;
+}
+
+const char* MappedFile::data() const {
+    return begin;
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
+
+std::string_view MappedFile::view() const {
+    return {begin, length};
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
\ No newline at end of file
@@ -1,36 +1,146 @@
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
+#include <unordered_set>
 
 #include <NFA.h>
-#include <Setup.h>
+#include <Parser.h>
+#include <Profile.h>
 #include <UserWarn.h>
 
 NFA::NFA(const std::string& file) {
-    const Setup setup(file);
-    setSigma(setup.getSigma());
-    setStates(setup.getStates());
-    setTransitions(setup.getTransitions());
-    setStartState();
+    load(Parser(file));
+    compile();
 }
 
-bool NFA::process(const std::string& word) const{
-    std::vector<std::shared_ptr<State>> currentStates = {startState};
-    assert(currentStates[0] != nullptr);
+void NFA::compile() {
+    const size_t stateCount = getStateCount();
+
+    classes = ByteClasses(edgeOffsets, edgeSymbols, edgeTargets);
+    std::vector<uint32_t> closureOffsets, closureTargets;
+    computeClosures(closureOffsets, closureTargets);
+
+    // Successor lists already include the epsilon-closure of every target, so matching never expands closures.
+    computeSuccessors(classes, closureOffsets, closureTargets, successorOffsets, successorTargets);
+    initialStates.resize(stateCount);
+    finalStates.resize(stateCount);
+    for (size_t i = 0; i < stateCount; ++i) {
+        if (finals[i]) {
+            finalStates.insert(i);
+        }
+    }
+
+    if (startState != noState) {
+        for (uint32_t j = closureOffsets[startState]; j < closureOffsets[startState + 1]; ++j) {
+            initialStates.insert(closureTargets[j]);
+        }
+    }
+}
+
+void NFA::setMode(const Mode mode_) {
+    mode = mode_;
+}
+
+NFA::Mode NFA::getMode() const {
+    return mode;
+}
+
+bool NFA::process(const std::string_view word) const {
+    return mode == Mode::Bitset ? processBitset(word) : processGraph(word);
+}
+
+bool NFA::processBitset(const std::string_view word) const {
+    assert(!initialStates.empty());
+
+    thread_local StateSet current, next;
+    current = initialStates;
+    if (next.size() != current.size()) {
+        next.resize(current.size());
+    }
+
+    DFA_NFA_PROFILE_SCOPE(this);
+    for (size_t i = 0; i < word.size(); ++i) {
+        const uint8_t byteClass = classes[static_cast<unsigned char>(word[i])];
+
+        next.clear();
+        current.forEach([&](const size_t state) {
+            DFA_NFA_PROFILE_TRANSITION(state, word[i]);
+            addSuccessors(state, byteClass, next);
+        });
+        std::swap(current, next);
+        if (current.empty()) {
+            DFA_NFA_PROFILE_RESULT(false, i);
+            return false;
+        }
+    }
+
+    if constexpr (Profile::enabled) {
+        current.forEach([&](const size_t state) {
+            DFA_NFA_PROFILE_VISIT(state);
+        });
+    }
+    DFA_NFA_PROFILE_RESULT(accepts(current), word.size());
+    return accepts(current);
+}
+
+bool NFA::step(StateSet& current, StateSet& next, const std::string_view chunk) const {
+    for (const auto& symbol : chunk) {
+        const uint8_t byteClass = classes[static_cast<unsigned char>(symbol)];
+
+        next.clear();
+        current.forEach([&](const size_t state) {
+            addSuccessors(state, byteClass, next);
+        });
+        std::swap(current, next);
+        if (current.empty()) {
+            return false;
+        }
+    }
+
+    return !current.empty();
+}
+
+const StateSet& NFA::getInitialStates() const {
+    return initialStates;
+}
+
+bool NFA::accepts(const StateSet& current) const {
+    return current.intersects(finalStates);
+}
+
+bool NFA::processGraph(const std::string_view word) const{
+    assert(startState != noState);
+    std::vector<uint32_t> currentStates = {startState};
+    expandGraphClosure(currentStates);
 
     for (const auto & symbol : word) {
-        std::vector<std::shared_ptr<State>> newStates;
+        std::vector<uint32_t> newStates;
         for (const auto & state : currentStates) {
-            auto transitionsWithSymbol = state->transitions.equal_range(symbol);
-            for (auto it = transitionsWithSymbol.first; it != transitionsWithSymbol.second; ++it) {
-                newStates.push_back(it->second);
+            const auto first = edgeSymbols.begin() + edgeOffsets[state];
+            const auto [low, high] = std::equal_range(first, edgeSymbols.begin() + edgeOffsets[state + 1], symbol);
+            for (auto it = low; it != high; ++it) {
+                newStates.push_back(edgeTargets[it - edgeSymbols.begin()]);
             }
         }
         currentStates = newStates;
+        expandGraphClosure(currentStates);
     }
 
     for (const auto & state : currentStates) {
-        if (state->final) {
+        if (finals[state]) {
             return true;
         }
     }
     return false;
+}
+
+void NFA::expandGraphClosure(std::vector<uint32_t>& currentStates) const {
+    std::unordered_set<uint32_t> reached;
+    for (size_t i = 0; i < currentStates.size(); ++i) {
+        for (uint32_t edge = epsilonOffsets[currentStates[i]]; edge < epsilonOffsets[currentStates[i] + 1]; ++edge) {
+            if (reached.insert(epsilonTargets[edge]).second) {
+                currentStates.push_back(epsilonTargets[edge]);
+            }
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,346 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#include <Parser.h>
+#include <UserWarn.h>
+
+namespace {
+    std::string_view trim(const std::string_view token) {
+        const char* begin = token.data();
+        const char* end = begin + token.size();
+        while (begin < end && *begin == ' ') {
+            ++begin;
+        }
+        while (end > begin && end[-1] == ' ') {
+            --end;
+        }
+        return {begin, static_cast<size_t>(end - begin)};
+    }
+
+    // Every section keyword contains one of these capitals, so plain data lines skip the keyword search.
+    bool mayBeHeader(const std::string_view line) {
+        for (const auto& c : line) {
+            if (c == 'S' || c == 'T' || c == 'E') {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void prefetch(const void* address) {
+#if defined(__GNUC__)
+        __builtin_prefetch(address);
+#endif
+    }
+
+    template <typename Visitor>
+    void forEachToken(const std::string_view line, Visitor&& visit) {
+        const char* position = line.data();
+        const char* const end = position + line.size();
+        for (size_t index = 0;; ++index) {
+            const auto* comma = static_cast<const char*>(std::memchr(position, ',', end - position));
+            const char* tokenEnd = comma ? comma : end;
+            visit(trim({position, static_cast<size_t>(tokenEnd - position)}), index);
+            if (!comma) {
+                return;
+            }
+            position = comma + 1;
+        }
+    }
+}
+
+// Calls visit(section, line, lineNumber) for every line that is neither a header, a comment nor empty.
+template <typename Visitor>
+void Parser::forEachLine(const std::string_view text, Visitor&& visit) {
+    Section section = Section::None;
+    size_t lineNumber = 0, position = 0;
+
+    while (position < text.size()) {
+        const auto* newline = static_cast<const char*>(std::memchr(text.data() + position, '\n', text.size() - position));
+        const size_t end = newline ? static_cast<size_t>(newline - text.data()) : text.size();
+        std::string_view line = text.substr(position, end - position);
+        position = end + 1;
+        ++lineNumber;
+
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+
+        if (mayBeHeader(line)) {
+            if (line.find("Sigma") != std::string_view::npos) {
+                section = Section::Sigma;
+                continue;
+            }
+            if (line.find("States") != std::string_view::npos) {
+                section = Section::States;
+                continue;
+            }
+            if (line.find("Transitions") != std::string_view::npos) {
+                section = Section::Transitions;
+                continue;
+            }
+            if (line.find("End") != std::string_view::npos) {
+                section = Section::None;
+                continue;
+            }
+        }
+
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+        visit(section, line, lineNumber);
+    }
+}
+
+Parser::Parser(const std::string& file_) : file(file_) {
+    const std::string_view text = file.view();
+    // Reserved address space is only committed when written, so an estimate from the file size costs no memory
+    // for short files and saves every reallocation of the transition list for long ones.
+    transitions.reserve(text.size() / 16);
+
+    forEachLine(text, [&](const Section section, const std::string_view line, const size_t lineNumber) {
+        // Queued transitions are interned before any other line, so errors still come out in file order.
+        if (section != Section::Transitions && pendingCount) {
+            flushTransitions();
+        }
+        switch (section) {
+            case Section::Sigma: sigma.push_back(line.front()); break;
+            case Section::States: parseState(line, lineNumber); break;
+            case Section::Transitions: parseTransition(line, lineNumber); break;
+            case Section::None: break;
+        }
+    });
+    flushTransitions();
+
+    verify();
+}
+
+uint32_t Parser::hash(const std::string_view name) {
+    uint64_t h = 0xcbf29ce484222325;
+    for (const auto& c : name) {
+        h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+    }
+    return static_cast<uint32_t>(h ^ (h >> 29));
+}
+
+void Parser::grow() {
+    std::vector<uint64_t> previous(std::max<size_t>(1024, slots.size() * 2), 0);
+    previous.swap(slots);
+    const size_t mask = slots.size() - 1;
+    for (const auto& entry : previous) {
+        if (!entry) {
+            continue;
+        }
+        size_t slot = (entry >> 32) & mask;
+        while (slots[slot]) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = entry;
+    }
+}
+
+// Each slot packs the name's 32-bit hash above its id + 1, so probing rarely has to touch the names,
+// and interned names are copied into one compact arena instead of pointing back into the whole file.
+uint32_t Parser::intern(const std::string_view name) {
+    return intern(name, hash(name));
+}
+
+uint32_t Parser::intern(const std::string_view name, const uint32_t h) {
+    if (2 * (getStateCount() + 1) > slots.size()) {
+        grow();
+    }
+
+    const size_t mask = slots.size() - 1;
+    size_t slot = h & mask;
+    while (slots[slot]) {
+        if (slots[slot] >> 32 == h && getName(static_cast<uint32_t>(slots[slot]) - 1) == name) {
+            return static_cast<uint32_t>(slots[slot]) - 1;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    const auto id = static_cast<uint32_t>(getStateCount());
+    slots[slot] = static_cast<uint64_t>(h) << 32 | (id + 1);
+    arena += name;
+    nameOffsets.push_back(static_cast<uint32_t>(arena.size()));
+    declared.push_back(0);
+    initial.push_back(0);
+    final.push_back(0);
+    return id;
+}
+
+void Parser::parseState(const std::string_view line, const size_t lineNumber) {
+    std::string_view name;
+    bool isInitial = false, isFinal = false;
+
+    forEachToken(line, [&](const std::string_view token, size_t) {
+        if (token == "S") {
+            if (hasInitialState) {
+                UserWarn("Initial state should be unique", line, lineNumber);
+            }
+            hasInitialState = isInitial = true;
+        } else if (token == "F") {
+            isFinal = true;
+        } else {
+            name = token;
+        }
+    });
+
+    if (name.empty()) {
+        UserWarn("State must have a name", line, lineNumber);
+    }
+
+    const uint32_t id = intern(name);
+    if (declared[id]) {
+        UserWarn("State is declared more than once", line, lineNumber);
+    }
+    declared[id] = 1;
+    initial[id] = isInitial;
+    final[id] = isFinal;
+    declarations.push_back(id);
+}
+
+void Parser::parseTransition(const std::string_view line, const size_t lineNumber) {
+    auto& transition = pending[pendingCount++];
+    transition.line = line;
+    transition.lineNumber = lineNumber;
+    transition.symbol = transition.to = {};
+
+    forEachToken(line, [&](const std::string_view token, const size_t index) {
+        switch (index) {
+            case 0: transition.from = token; break;
+            case 1: transition.symbol = token; break;
+            case 2: transition.to = token; break;
+            default: break;
+        }
+    });
+    transition.toHash = hash(transition.to);
+
+    if (pendingCount == pending.size()) {
+        flushTransitions();
+    }
+}
+
+// Targets are spread over the whole state table, so a lookup per line would wait on a cache miss for the slot,
+// another for the name offset and a third for the name. A batch issues each of these rounds for all its targets
+// at once and only then interns them in order, which still numbers states by first mention.
+void Parser::flushTransitions() {
+    if (slots.empty()) {
+        grow();
+    }
+
+    const size_t mask = slots.size() - 1;
+    const auto candidate = [&](const PendingTransition& transition) -> uint32_t {
+        const uint64_t entry = slots[transition.toHash & mask];
+        return entry >> 32 == transition.toHash ? static_cast<uint32_t>(entry) : 0;
+    };
+    for (size_t i = 0; i < pendingCount; ++i) {
+        prefetch(&slots[pending[i].toHash & mask]);
+    }
+    for (size_t i = 0; i < pendingCount; ++i) {
+        if (const uint32_t id = candidate(pending[i])) {
+            prefetch(&nameOffsets[id - 1]);
+        }
+    }
+    for (size_t i = 0; i < pendingCount; ++i) {
+        if (const uint32_t id = candidate(pending[i])) {
+            prefetch(arena.data() + nameOffsets[id - 1]);
+        }
+    }
+
+    for (size_t i = 0; i < pendingCount; ++i) {
+        const auto& [line, lineNumber, from, symbol, to, toHash] = pending[i];
+        const bool epsilon = std::find(std::begin(epsilonSymbols), std::end(epsilonSymbols), symbol) != std::end(epsilonSymbols);
+        if (symbol.length() != 1 && !epsilon) {
+            UserWarn("The symbol should be an unique character", line, lineNumber);
+        }
+
+        // Transitions are usually grouped by source state, so the previous source is worth remembering.
+        if (from != lastFromName || transitions.empty()) {
+            lastFromName = from;
+            lastFrom = intern(from);
+        }
+        transitions.push_back({lastFrom, epsilon ? '\0' : symbol.front(), intern(to, toHash), epsilon});
+    }
+    pendingCount = 0;
+}
+
+void Parser::verify() {
+    if (declarations.empty()) {
+        UserWarn("There are no states declared for this DFA");
+    }
+
+    bool hasFinalState = false;
+    for (const auto& id : declarations) {
+        hasFinalState = hasFinalState || final[id];
+    }
+    if (!hasFinalState) {
+        UserWarn("At least one final state required");
+    }
+
+    std::array<bool, 256> inSigma{};
+    for (const auto& symbol : sigma) {
+        inSigma[static_cast<unsigned char>(symbol)] = true;
+    }
+
+    for (size_t i = 0; i < transitions.size(); ++i) {
+        const auto& [from, symbol, to, epsilon] = transitions[i];
+        if (!epsilon && !inSigma[static_cast<unsigned char>(symbol)]) {
+            const size_t lineNumber = transitionLine(i);
+            UserWarn("The symbol is not defined in Sigma", lineAt(lineNumber), lineNumber);
+        }
+        if (!declared[from] || !declared[to]) {
+            const size_t lineNumber = transitionLine(i);
+            UserWarn("There are undefined states", lineAt(lineNumber), lineNumber);
+        }
+    }
+}
+
+// Line numbers are only needed for an error, so they are found again by rescanning rather than stored per transition.
+size_t Parser::transitionLine(const size_t index) const {
+    size_t seen = 0, found = 0;
+    forEachLine(file.view(), [&](const Section section, std::string_view, const size_t lineNumber) {
+        if (section == Section::Transitions && seen++ == index) {
+            found = lineNumber;
+        }
+    });
+    return found;
+}
+
+std::string_view Parser::lineAt(const size_t lineNumber) const {
+    std::string_view text = file.view();
+    for (size_t i = 1; i < lineNumber; ++i) {
+        text.remove_prefix(std::min(text.size(), text.find('\n') + 1));
+    }
+    return text.substr(0, text.find('\n'));
+}
+
+const std::vector<char>& Parser::getSigma() const {
+    return sigma;
+}
+
+size_t Parser::getStateCount() const {
+    return nameOffsets.size() - 1;
+}
+
+std::string_view Parser::getName(const uint32_t state) const {
+    return std::string_view(arena).substr(nameOffsets[state], nameOffsets[state + 1] - nameOffsets[state]);
+}
+
+const std::vector<uint32_t>& Parser::getDeclarations() const {
+    return declarations;
+}
+
+const std::vector<Parser::Transition>& Parser::getTransitions() const {
+    return transitions;
+}
+
+bool Parser::isInitial(const uint32_t state) const {
+    return initial[state];
+}
+
+bool Parser::isFinal(const uint32_t state) const {
+    return final[state];
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include <FiniteAutomaton.h>
+#include <Profile.h>
+
+namespace {
+    struct ThreadCounters {
+        std::unordered_map<const FiniteAutomaton*, Profile::Counters> automata;
+    };
+
+    std::mutex registryMutex;
+    std::vector<std::shared_ptr<ThreadCounters>> registry;
+
+    // Tables are shared with the registry so that counts survive the pool threads that produced them.
+    ThreadCounters& threadCounters() {
+        thread_local const std::shared_ptr<ThreadCounters> counters = [] {
+            auto created = std::make_shared<ThreadCounters>();
+            std::lock_guard lock(registryMutex);
+            registry.push_back(created);
+            return created;
+        }();
+        return *counters;
+    }
+
+    template <typename Key>
+    std::vector<std::pair<Key, uint64_t>> hottest(std::vector<std::pair<Key, uint64_t>> entries) {
+        const size_t kept = std::min(entries.size(), Profile::reportLimit);
+        std::partial_sort(entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(kept), entries.end(), [](const auto& left, const auto& right) {
+            return left.second != right.second ? left.second > right.second : left.first < right.first;
+        });
+        entries.resize(kept);
+        return entries;
+    }
+}
+
+Profile::Counters& Profile::local(const FiniteAutomaton* automaton) {
+    return threadCounters().automata[automaton];
+}
+
+// Must only run while no thread is matching with `automaton`; its counters are removed once merged.
+Profile::Report Profile::collect(const FiniteAutomaton& automaton) {
+    Counters merged;
+    {
+        std::lock_guard lock(registryMutex);
+        for (const auto& thread : registry) {
+            const auto found = thread->automata.find(&automaton);
+            if (found == thread->automata.end()) {
+                continue;
+            }
+            const Counters& counters = found->second;
+            if (counters.visits.size() > merged.visits.size()) {
+                merged.visits.resize(counters.visits.size(), 0);
+            }
+            for (size_t state = 0; state < counters.visits.size(); ++state) {
+                merged.visits[state] += counters.visits[state];
+            }
+            for (const auto& [key, count] : counters.transitions) {
+                merged.transitions[key] += count;
+            }
+            for (const auto& [position, count] : counters.rejectPositions) {
+                merged.rejectPositions[position] += count;
+            }
+            merged.accepted += counters.accepted;
+            merged.rejected += counters.rejected;
+            thread->automata.erase(found);
+        }
+    }
+
+    Report report;
+    report.accepted = merged.accepted;
+    report.rejected = merged.rejected;
+
+    std::vector<std::pair<size_t, uint64_t>> states;
+    for (size_t state = 0; state < merged.visits.size(); ++state) {
+        if (merged.visits[state]) {
+            states.emplace_back(state, merged.visits[state]);
+        }
+    }
+    for (const auto& [state, count] : hottest(std::move(states))) {
+        report.states.emplace_back(automaton.getStateName(state), count);
+    }
+
+    std::vector<std::pair<uint64_t, uint64_t>> transitions(merged.transitions.begin(), merged.transitions.end());
+    for (const auto& [key, count] : hottest(std::move(transitions))) {
+        report.transitions.emplace_back(std::string(automaton.getStateName(key >> 8)) + ", " + static_cast<char>(key & 0xFF), count);
+    }
+
+    std::vector<std::pair<size_t, uint64_t>> positions(merged.rejectPositions.begin(), merged.rejectPositions.end());
+    report.rejectPositions = hottest(std::move(positions));
+    return report;
+}
+
+void Profile::print(const std::string& name, const Report& report, std::ostream& out) {
+    out << std::endl << "Profile: " << name << std::endl;
+    out << "Accepted: " << report.accepted << ", rejected: " << report.rejected << std::endl;
+    out << "Hottest states:" << std::endl;
+    for (const auto& [state, count] : report.states) {
+        out << "    " << state << ": " << count << std::endl;
+    }
+    out << "Hottest transitions:" << std::endl;
+    for (const auto& [transition, count] : report.transitions) {
+        out << "    " << transition << ": " << count << std::endl;
+    }
+    out << "Most frequent reject positions:" << std::endl;
+    for (const auto& [position, count] : report.rejectPositions) {
+        out << "    " << position << ": " << count << std::endl;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include <format>
+#include <stdexcept>
+
+#include <Regex.h>
+
+Regex::Regex(const std::string_view pattern_, NFA& nfa_) : pattern(pattern_), nfa(nfa_) {}
+
+NFA Regex::compile(const std::string_view pattern) {
+    NFA nfa;
+    Regex regex(pattern, nfa);
+
+    const Fragment root = regex.parseAlternation();
+    if (!regex.atEnd()) {
+        regex.fail("Unbalanced ')'");
+    }
+
+    nfa.startState = static_cast<uint32_t>(root.start);
+    nfa.finals[root.accept] = true;
+    nfa.setTransitions(regex.transitions);
+    nfa.compile();
+    return nfa;
+}
+
+size_t Regex::newState() {
+    return nfa.addState(std::format("r{}", nfa.getStateCount()), false);
+}
+
+void Regex::connect(const size_t from, const char symbol, const size_t to) {
+    nfa.sigma.insert(symbol);
+    transitions.push_back({static_cast<uint32_t>(from), symbol, static_cast<uint32_t>(to)});
+}
+
+void Regex::link(const size_t from, const size_t to) {
+    transitions.push_back({static_cast<uint32_t>(from), 0, static_cast<uint32_t>(to), true});
+}
+
+bool Regex::atEnd() const {
+    return position == pattern.size();
+}
+
+void Regex::fail(const std::string& reason) const {
+    throw std::runtime_error(std::format("Invalid regular expression at position {}: {}", position, reason));
+}
+
+Regex::Fragment Regex::parseAlternation() {
+    Fragment left = parseConcatenation();
+    while (!atEnd() && pattern[position] == '|') {
+        ++position;
+        const Fragment right = parseConcatenation();
+
+        const Fragment both{newState(), newState()};
+        link(both.start, left.start);
+        link(both.start, right.start);
+        link(left.accept, both.accept);
+        link(right.accept, both.accept);
+        left = both;
+    }
+    return left;
+}
+
+Regex::Fragment Regex::parseConcatenation() {
+    if (atEnd() || pattern[position] == '|' || pattern[position] == ')') {
+        const Fragment empty{newState(), newState()};
+        link(empty.start, empty.accept);
+        return empty;
+    }
+
+    Fragment sequence = parseRepetition();
+    while (!atEnd() && pattern[position] != '|' && pattern[position] != ')') {
+        const Fragment next = parseRepetition();
+        link(sequence.accept, next.start);
+        sequence.accept = next.accept;
+    }
+    return sequence;
+}
+
+Regex::Fragment Regex::parseRepetition() {
+    Fragment inner = parseAtom();
+    while (!atEnd() && (pattern[position] == '*' || pattern[position] == '+' || pattern[position] == '?')) {
+        const char op = pattern[position++];
+        const Fragment outer{newState(), newState()};
+        link(outer.start, inner.start);
+        link(inner.accept, outer.accept);
+        if (op != '+') {
+            link(outer.start, outer.accept);
+        }
+        if (op != '?') {
+            link(inner.accept, inner.start);
+        }
+        inner = outer;
+    }
+    return inner;
+}
+
+Regex::Fragment Regex::parseAtom() {
+    switch (pattern[position]) {
+        case '(': {
+            ++position;
+            const Fragment group = parseAlternation();
+            if (atEnd() || pattern[position] != ')') {
+                fail("Missing ')'");
+            }
+            ++position;
+            return group;
+        }
+        case '[':
+            return parseClass();
+        case '*':
+        case '+':
+        case '?':
+            fail("Nothing to repeat");
+        case ']':
+            fail("Unbalanced ']'");
+        default: {
+            const Fragment literal{newState(), newState()};
+            connect(literal.start, parseLiteral(), literal.accept);
+            return literal;
+        }
+    }
+}
+
+Regex::Fragment Regex::parseClass() {
+    ++position;
+    const Fragment range{newState(), newState()};
+
+    bool empty = true;
+    while (!atEnd() && pattern[position] != ']') {
+        const char low = parseLiteral();
+        char high = low;
+        if (position + 1 < pattern.size() && pattern[position] == '-' && pattern[position + 1] != ']') {
+            ++position;
+            high = parseLiteral();
+            if (static_cast<unsigned char>(high) < static_cast<unsigned char>(low)) {
+                fail("Inverted character range");
+            }
+        }
+        for (unsigned symbol = static_cast<unsigned char>(low); symbol <= static_cast<unsigned char>(high); ++symbol) {
+            connect(range.start, static_cast<char>(symbol), range.accept);
+        }
+        empty = false;
+    }
+
+    if (atEnd()) {
+        fail("Missing ']'");
+    }
+    if (empty) {
+        fail("Empty character class");
+    }
+    ++position;
+    return range;
+}
+
+char Regex::parseLiteral() {
+    if (pattern[position] == '\\') {
+        if (++position == pattern.size()) {
+            fail("Trailing '\\'");
+        }
+    }
+    return pattern[position++];
+}
\ No newline at end of file
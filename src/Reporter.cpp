@@ -0,0 +1,162 @@
+#include <charconv>
+
+#include <Reporter.h>
+
+Reporter::Reporter(std::ostream& out_) : out(out_) {
+    buffer.reserve(bufferCapacity + 4096);
+}
+
+Reporter::~Reporter() {
+    flush();
+}
+
+std::unique_ptr<Reporter> Reporter::create(const Format format, std::ostream& out) {
+    switch (format) {
+        case Format::Csv:
+            return std::make_unique<CsvReporter>(out);
+        case Format::JsonLines:
+            return std::make_unique<JsonLinesReporter>(out);
+        case Format::Bitmap:
+            return std::make_unique<BitmapReporter>(out);
+        default:
+            return std::make_unique<HumanReporter>(out);
+    }
+}
+
+std::optional<Reporter::Format> Reporter::parseFormat(const std::string_view name) {
+    if (name == "human") {
+        return Format::Human;
+    }
+    if (name == "csv") {
+        return Format::Csv;
+    }
+    if (name == "jsonl") {
+        return Format::JsonLines;
+    }
+    if (name == "bitmap") {
+        return Format::Bitmap;
+    }
+    return std::nullopt;
+}
+
+void Reporter::writeNumber(const uint64_t value) {
+    char digits[20];
+    const auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, end);
+}
+
+void Reporter::flush() {
+    if (!buffer.empty()) {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+    out.flush();
+}
+
+void HumanReporter::beginConfig(const std::string& config, size_t) {
+    write("\nConfiguration: ");
+    write(config);
+    write('\n');
+}
+
+void HumanReporter::result(const std::string_view word, size_t, const bool accepted) {
+    write("Word: ");
+    write(word);
+    write(accepted ? " >> \033[32mAccepted!\033[0m\n" : " >> \033[31mRejected!\033[0m\n");
+    endRecord();
+}
+
+void CsvReporter::beginConfig(const std::string& config_, size_t) {
+    config.clear();
+    config += '"';
+    for (const char symbol : config_) {
+        config += symbol;
+        if (symbol == '"') {
+            config += '"';
+        }
+    }
+    config += '"';
+
+    if (header) {
+        write("config,index,word,accepted\n");
+        header = false;
+    }
+}
+
+void CsvReporter::result(const std::string_view word, const size_t index, const bool accepted) {
+    write(config);
+    write(',');
+    writeNumber(index);
+    write(",\"");
+    for (const char symbol : word) {
+        write(symbol);
+        if (symbol == '"') {
+            write('"');
+        }
+    }
+    write(accepted ? "\",1\n" : "\",0\n");
+    endRecord();
+}
+
+// Escapes quotes, backslashes and control bytes; other bytes are passed through unchanged.
+void JsonLinesReporter::writeString(const std::string_view text) {
+    static constexpr char hex[] = "0123456789abcdef";
+    write('"');
+    for (const char symbol : text) {
+        const auto byte = static_cast<unsigned char>(symbol);
+        if (symbol == '"' || symbol == '\\') {
+            write('\\');
+            write(symbol);
+        } else if (byte < 0x20) {
+            write("\\u00");
+            write(hex[byte >> 4]);
+            write(hex[byte & 0xF]);
+        } else {
+            write(symbol);
+        }
+    }
+    write('"');
+}
+
+void JsonLinesReporter::beginConfig(const std::string& config_, size_t) {
+    config = config_;
+}
+
+void JsonLinesReporter::result(const std::string_view word, const size_t index, const bool accepted) {
+    write("{\"config\":");
+    writeString(config);
+    write(",\"index\":");
+    writeNumber(index);
+    write(",\"word\":");
+    writeString(word);
+    write(accepted ? ",\"accepted\":true}\n" : ",\"accepted\":false}\n");
+    endRecord();
+}
+
+void BitmapReporter::beginConfig(const std::string& config, const size_t wordCount) {
+    write(config);
+    write('\n');
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+        write(static_cast<char>(static_cast<uint64_t>(wordCount) >> (8 * i) & 0xFF));
+    }
+    pending = 0;
+    pendingBits = 0;
+}
+
+void BitmapReporter::result(std::string_view, size_t, const bool accepted) {
+    pending |= static_cast<uint8_t>(accepted) << pendingBits;
+    if (++pendingBits == 8) {
+        write(static_cast<char>(pending));
+        pending = 0;
+        pendingBits = 0;
+        endRecord();
+    }
+}
+
+void BitmapReporter::endConfig() {
+    if (pendingBits) {
+        write(static_cast<char>(pending));
+        pending = 0;
+        pendingBits = 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <utility>
+
+#include <ThreadPool.h>
+
+thread_local ThreadPool* ThreadPool::currentPool = nullptr;
+thread_local size_t ThreadPool::currentWorker = 0;
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    threadCount = std::max<size_t>(threadCount, 1);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    // Tasks spawned from a worker stay on its own deque; others are spread round-robin.
+    const size_t target = currentPool == this ? currentWorker : nextWorker++ % workers.size();
+
+    pending++;
+    {
+        std::lock_guard lock(mutex);
+        queued++;
+    }
+    {
+        std::lock_guard lock(workers[target]->mutex);
+        workers[target]->tasks.push_back(std::move(task));
+    }
+    wakeup.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock lock(mutex);
+    idle.wait(lock, [this] { return pending == 0; });
+    if (failure) {
+        std::rethrow_exception(std::exchange(failure, nullptr));
+    }
+}
+
+size_t ThreadPool::size() const {
+    return threads.size();
+}
+
+bool ThreadPool::tryRun(const size_t self) {
+    std::function<void()> task;
+
+    for (size_t i = 0; i < workers.size() && !task; ++i) {
+        Worker& victim = *workers[(self + i) % workers.size()];
+        std::lock_guard lock(victim.mutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+        // The owner works LIFO for locality, thieves take the oldest task from the other end.
+        if (i == 0) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+        } else {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+    queued--;
+
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard lock(mutex);
+        if (!failure) {
+            failure = std::current_exception();
+        }
+    }
+
+    if (--pending == 0) {
+        std::lock_guard lock(mutex);
+        idle.notify_all();
+    }
+    return true;
+}
+
+void ThreadPool::workerLoop(const size_t self) {
+    currentPool = this;
+    currentWorker = self;
+
+    while (true) {
+        if (tryRun(self)) {
+            continue;
+        }
+        std::unique_lock lock(mutex);
+        wakeup.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
\ No newline at end of file
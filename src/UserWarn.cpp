@@ -1,17 +1,44 @@
 #include "UserWarn.h"
 
-void UserWarn::configurationError(const std::string& reason, const std::string& line) {
-    if (!line.empty()) {
+thread_local bool UserWarn::deferred = false;
+
+void UserWarn::configurationError(const std::string& reason, const std::string& line, const size_t lineNumber) {
+    if (deferred) {
+        throw Error(reason, line, lineNumber);
+    }
+    if (lineNumber) {
+        std::cout << "Issue at line " << lineNumber << ": " << line << std::endl;
+    } else if (!line.empty()) {
         std::cout << "Issue at: " << line << std::endl;
     }
     std::cerr << "Configuration error: " << reason << std::endl;
     exit(1);
 }
 
+UserWarn::Error::Error(const std::string& reason, std::string line_, const size_t lineNumber_)
+    : std::runtime_error(reason), line(std::move(line_)), lineNumber(lineNumber_) {}
+
+void UserWarn::Error::report() const {
+    deferred = false;
+    UserWarn::configurationError(what(), line, lineNumber);
+}
+
+UserWarn::Deferral::Deferral() : previous(deferred) {
+    deferred = true;
+}
+
+UserWarn::Deferral::~Deferral() {
+    deferred = previous;
+}
+
 UserWarn::UserWarn(const std::string& reason) {
     UserWarn::configurationError(reason);
 }
 
 UserWarn::UserWarn(const std::string& reason, const std::string& line) {
     UserWarn::configurationError(reason, line);
+}
+
+UserWarn::UserWarn(const std::string& reason, const std::string_view line, const size_t lineNumber) {
+    UserWarn::configurationError(reason, std::string(line), lineNumber);
 }
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include <algorithm>
+
+#include <WordSource.h>
+
+WordSource::WordSource(const std::string& filename, const size_t chunkBytes) : file(filename) {
+    const std::string_view text = file.view();
+
+    size_t begin = 0;
+    while (begin < text.size()) {
+        size_t end = std::min(text.size(), begin + std::max<size_t>(chunkBytes, 1));
+        if (end < text.size()) {
+            const size_t newline = text.find('\n', end - 1);
+            end = newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+
+        Chunk chunk{text.substr(begin, end - begin), wordCount, 0};
+        chunk.wordCount = std::count(chunk.text.begin(), chunk.text.end(), '\n') + !chunk.text.ends_with('\n');
+        wordCount += chunk.wordCount;
+        chunks.push_back(chunk);
+        begin = end;
+    }
+}
+
+const std::vector<WordSource::Chunk>& WordSource::getChunks() const {
+    return chunks;
+}
+
+size_t WordSource::size() const {
+    return wordCount;
+}
\ No newline at end of file
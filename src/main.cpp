@@ -1,9 +1,121 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <CompiledAutomaton.h>
+#include <Reporter.h>
 #include <Test.h>
 #include <DFA.h>
 #include <NFA.h>
+#include <WordSource.h>
+
+static int usage() {
+    std::cerr << "Usage: DFA_NFA [--threads=N] [--combined] [--format=human|csv|jsonl|bitmap] [--output=file]" << std::endl;
+    return 1;
+}
+
+// A positive decimal count; std::stoul alone would accept "-1" and wrap it to SIZE_MAX.
+static size_t parseCount(const std::string& text) {
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+        throw std::invalid_argument(text);
+    }
+    const size_t value = std::stoul(text);
+    if (value == 0) {
+        throw std::invalid_argument(text);
+    }
+    return value;
+}
+
+static int compile(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 4 || (arguments[1] != "dfa" && arguments[1] != "nfa")) {
+        std::cerr << "Usage: DFA_NFA compile <dfa|nfa> <config> <output>" << std::endl;
+        return 1;
+    }
+    try {
+        if (arguments[1] == "dfa") {
+            CompiledAutomaton::save(DFA(arguments[2]), arguments[3]);
+        } else {
+            CompiledAutomaton::save(NFA(arguments[2]), arguments[3]);
+        }
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+static int match(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 3) {
+        std::cerr << "Usage: DFA_NFA match <compiled automaton> <words>" << std::endl;
+        return 1;
+    }
+    try {
+        const CompiledAutomaton automaton(arguments[1]);
+        const WordSource words(arguments[2]);
+        for (const auto& chunk : words.getChunks()) {
+            WordSource::forEach(chunk.text, [&](const std::string_view word) {
+                std::cout << "Word: " << word << " >> ";
+                automaton.process(word) ? std::cout << "\033[32m" << "Accepted!" << "\033[0m" << std::endl : std::cout << "\033[31m" << "Rejected!"<< "\033[0m" << std::endl;
+            });
+        }
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    const std::vector<std::string> arguments(argv + 1, argv + argc);
+    if (!arguments.empty() && arguments[0] == "compile") {
+        return compile(arguments);
+    }
+    if (!arguments.empty() && arguments[0] == "match") {
+        return match(arguments);
+    }
+
+    size_t threads = 1;
+    Reporter::Format format = Reporter::Format::Human;
+    std::string output;
+    bool combined = false;
+    try {
+        for (const auto& argument : arguments) {
+            if (argument.starts_with("--threads=")) {
+                // Oversubscribing past a few workers per core only adds scheduling overhead.
+                threads = std::min<size_t>(parseCount(argument.substr(10)), 4 * std::max(1u, std::thread::hardware_concurrency()));
+            } else if (argument.starts_with("--format=")) {
+                const auto parsed = Reporter::parseFormat(argument.substr(9));
+                if (!parsed) {
+                    return usage();
+                }
+                format = *parsed;
+            } else if (argument.starts_with("--output=")) {
+                output = argument.substr(9);
+            } else if (argument == "--combined") {
+                combined = true;
+            } else {
+                return usage();
+            }
+        }
+    } catch (const std::logic_error&) {
+        return usage();
+    }
+
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Could not open output file: " << output << std::endl;
+            return 1;
+        }
+    }
+    const std::shared_ptr<Reporter> reporter = Reporter::create(format, output.empty() ? std::cout : file);
 
-int main() {
-    Test<DFA> t1("words.in"); t1.run();
-    Test<NFA> t2("words.in"); t2.run();
+    Test<DFA> t1("words.in"); t1.setThreads(threads); t1.setCombined(combined); t1.setReporter(reporter); t1.run();
+    Test<NFA> t2("words.in"); t2.setThreads(threads); t2.setCombined(combined); t2.setReporter(reporter); t2.run();
     return 0;
 }
\ No newline at end of file
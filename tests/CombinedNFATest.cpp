@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <Classifier.h>
+#include <CombinedNFA.h>
+#include <NFA.h>
+#include <TestSupport.h>
+
+using TestSupport::check;
+
+namespace {
+    // Epsilon chains across states exercise the shared closure and successor construction.
+    constexpr std::string_view optionalA = R"(Sigma:
+a
+b
+End
+States:
+s, S
+t
+u, F
+End
+Transitions:
+s, eps, t
+s, a, t
+t, eps, u
+u, b, u
+End
+)";
+}
+
+int main() {
+    std::vector<std::string> configs = {TestSupport::writeConfig("combined_optional.in", optionalA)};
+    for (uint64_t seed = 1; seed <= 8; ++seed) {
+        configs.push_back(TestSupport::writeGenerated("combined_" + std::to_string(seed) + ".in", {15, 3, 2, 1.5, 0.3, seed}));
+    }
+
+    std::vector<NFA> separate;
+    for (const auto& config : configs) {
+        separate.emplace_back(config);
+    }
+    const CombinedNFA combined(configs);
+    // A tiny memory budget forces cache flushes and the per-word fallback to simulation.
+    Classifier cached(combined);
+    Classifier starved(combined, 1, 1);
+
+    for (const auto& word : TestSupport::allWords("abc", 6)) {
+        for (auto* classifier : {&cached, &starved}) {
+            const auto& accepted = classifier->classify(word);
+            for (uint32_t config = 0; config < configs.size(); ++config) {
+                const bool listed = std::find(accepted.begin(), accepted.end(), config) != accepted.end();
+                check(listed == separate[config].process(word), "config " + std::to_string(config) + ": combined result differs on \"" + word + "\"");
+            }
+        }
+    }
+    return TestSupport::finish();
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <CompiledAutomaton.h>
+#include <DFA.h>
+#include <NFA.h>
+#include <TestSupport.h>
+
+using TestSupport::check;
+
+namespace {
+    std::vector<char> readImage(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    // Writes a damaged copy of `image` and checks that loading it throws instead of trusting the bad index.
+    void checkRejected(const std::vector<char>& image, const std::function<void(std::vector<char>&)>& damage, const std::string& what) {
+        std::vector<char> copy = image;
+        damage(copy);
+        const std::string path = (TestSupport::directory() / "compiled_damaged.bin").string();
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(copy.data(), static_cast<std::streamsize>(copy.size()));
+
+        bool rejected = false;
+        try {
+            const CompiledAutomaton automaton(path);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        check(rejected, "corrupt image accepted: " + what);
+    }
+
+    CompiledAutomaton::Header& headerOf(std::vector<char>& image) {
+        return *reinterpret_cast<CompiledAutomaton::Header*>(image.data());
+    }
+
+    template <typename T>
+    T* sectionOf(std::vector<char>& image, const uint64_t offset) {
+        return reinterpret_cast<T*>(image.data() + offset);
+    }
+
+    template <typename FA>
+    void checkRoundTrip(const FA& automaton, const std::string& path, const std::string& name) {
+        CompiledAutomaton::save(automaton, path);
+        const CompiledAutomaton loaded(path);
+        check(loaded.getStateCount() == automaton.getStateCount(), name + ": state count changed");
+        for (uint32_t state = 0; state < automaton.getStateCount(); ++state) {
+            check(loaded.getStateName(state) == automaton.getStateName(state), name + ": name of state " + std::to_string(state) + " changed");
+        }
+        for (const auto& word : TestSupport::allWords("abc", 6)) {
+            check(loaded.process(word) == automaton.process(word), name + ": image disagrees on \"" + word + "\"");
+        }
+    }
+}
+
+int main() {
+    // 70 states leaves padding bits in the last bitmap word.
+    const std::string config = TestSupport::writeGenerated("compiled_random.in", {70, 3, 2, 1.5, 0.3, 7});
+    const NFA nfa(config);
+    const DFA dfa(nfa);
+    const std::string nfaPath = (TestSupport::directory() / "compiled_nfa.bin").string();
+    const std::string dfaPath = (TestSupport::directory() / "compiled_dfa.bin").string();
+    checkRoundTrip(nfa, nfaPath, "NFA");
+    checkRoundTrip(dfa, dfaPath, "DFA");
+
+    const auto nfaImage = readImage(nfaPath);
+    const auto dfaImage = readImage(dfaPath);
+    checkRejected(nfaImage, [](auto& image) { image.resize(image.size() / 2); }, "truncated");
+    checkRejected(nfaImage, [](auto& image) { image[0] = 'X'; }, "bad magic");
+    checkRejected(nfaImage, [](auto& image) { ++headerOf(image).version; }, "future version");
+    checkRejected(nfaImage, [](auto& image) {
+        sectionOf<uint32_t>(image, headerOf(image).targetsOffset)[0] = headerOf(image).stateCount;
+    }, "NFA target out of range");
+    checkRejected(nfaImage, [](auto& image) {
+        const uint32_t stateCount = headerOf(image).stateCount;
+        sectionOf<uint64_t>(image, headerOf(image).initialOffset)[stateCount / 64] |= uint64_t{1} << 63;
+    }, "initial state past the last state");
+    checkRejected(dfaImage, [](auto& image) {
+        sectionOf<int32_t>(image, headerOf(image).transitionsOffset)[0] = static_cast<int32_t>(headerOf(image).stateCount);
+    }, "DFA transition out of range");
+    checkRejected(dfaImage, [](auto& image) { headerOf(image).start = -2; }, "DFA start out of range");
+
+    bool missing = false;
+    try {
+        const CompiledAutomaton automaton((TestSupport::directory() / "compiled_missing.bin").string());
+    } catch (const std::runtime_error&) {
+        missing = true;
+    }
+    check(missing, "loading a missing image did not throw");
+    return TestSupport::finish();
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include <string>
+
+#include <DFA.h>
+#include <Matcher.h>
+#include <NFA.h>
+#include <TestSupport.h>
+
+using TestSupport::check;
+
+namespace {
+    // Words ending in "ab"; the NFA guesses where the suffix starts and has an epsilon hop into the guess.
+    constexpr std::string_view endsWithAb = R"(Sigma:
+a
+b
+End
+States:
+q0, S
+q1
+q2
+q3, F
+End
+Transitions:
+q0, a, q0
+q0, b, q0
+q0, eps, q1
+q1, a, q2
+q2, b, q3
+End
+)";
+
+    // Feeding a word in any split must give the same answer as processing it whole.
+    template <typename FA>
+    void checkSplits(const FA& automaton, const std::string& name) {
+        Matcher<FA> matcher(automaton);
+        for (const auto& word : TestSupport::allWords("ab", 8)) {
+            const bool expected = automaton.process(word);
+            for (size_t split = 0; split <= word.size(); ++split) {
+                matcher.reset();
+                matcher.feed(std::string_view(word).substr(0, split));
+                matcher.feed(std::string_view(word).substr(split));
+                check(matcher.isAccepting() == expected, name + ": split " + std::to_string(split) + " of \"" + word + "\" disagrees with process");
+            }
+
+            matcher.reset();
+            for (const char symbol : word) {
+                matcher.feed(std::string_view(&symbol, 1));
+            }
+            check(matcher.isAccepting() == expected, name + ": byte-at-a-time \"" + word + "\" disagrees with process");
+        }
+    }
+}
+
+int main() {
+    const NFA nfa(TestSupport::writeConfig("matcher_ab.in", endsWithAb));
+    const DFA dfa(nfa);
+    checkSplits(nfa, "NFA");
+    checkSplits(dfa, "DFA");
+
+    // A matcher keeps its state between feeds until reset, including past a dead state.
+    Matcher<DFA> matcher(dfa);
+    matcher.feed("ba");
+    check(!matcher.isAccepting(), "DFA: \"ba\" accepted");
+    matcher.feed("b");
+    check(matcher.isAccepting(), "DFA: \"bab\" rejected after resuming");
+    matcher.feed("c");
+    matcher.feed("ab");
+    check(!matcher.isAccepting(), "DFA: matcher left the dead state after a symbol outside the alphabet");
+    matcher.reset();
+    matcher.feed("ab");
+    check(matcher.isAccepting(), "DFA: reset did not return to the start state");
+
+    Matcher<NFA> nfaMatcher(nfa);
+    nfaMatcher.feed("c");
+    nfaMatcher.feed("ab");
+    check(!nfaMatcher.isAccepting(), "NFA: matcher revived after a symbol outside the alphabet");
+    return TestSupport::finish();
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include <string>
+
+#include <DFA.h>
+#include <NFA.h>
+#include <TestSupport.h>
+
+using TestSupport::check;
+
+namespace {
+    // Even number of a's, spelled with redundant states: e0/e1 and o0/o1 are pairwise equivalent, u is unreachable.
+    constexpr std::string_view evenAs = R"(Sigma:
+a
+b
+End
+States:
+e0, S, F
+o0
+e1, F
+o1
+u
+End
+Transitions:
+e0, a, o0
+e0, b, e1
+o0, a, e1
+o0, b, o1
+e1, a, o1
+e1, b, e0
+o1, a, e0
+o1, b, o0
+u, a, e0
+End
+)";
+
+    void checkEquivalent(const DFA& original, const DFA& minimal, const std::string_view alphabet, const std::string& name) {
+        for (const auto& word : TestSupport::allWords(alphabet, 10)) {
+            check(original.process(word) == minimal.process(word), name + ": minimization changed the answer for \"" + word + "\"");
+        }
+    }
+}
+
+int main() {
+    const std::string evenPath = TestSupport::writeConfig("minimize_even.in", evenAs);
+    const DFA even(evenPath);
+    DFA minimalEven(evenPath);
+    minimalEven.minimize();
+    checkEquivalent(even, minimalEven, "ab", "even a's");
+    check(minimalEven.getStateCount() == 2, "even a's: expected 2 states, got " + std::to_string(minimalEven.getStateCount()));
+    check(minimalEven.getBuildReport().unminimizedStates == 5 && minimalEven.getBuildReport().resultStates == 2, "even a's: build report does not record 5 -> 2 states");
+
+    // Minimizing a minimal DFA is a no-op.
+    minimalEven.minimize();
+    check(minimalEven.getStateCount() == 2, "even a's: second minimize changed the state count");
+
+    // Subset construction on random NFAs yields redundant DFAs; the minimum must agree with the NFA and never grow.
+    for (uint64_t seed = 1; seed <= 20; ++seed) {
+        const NFA nfa(TestSupport::writeGenerated("minimize_random.in", {10, 2, 2, 1.5, 0.3, seed}));
+        const DFA dfa(nfa);
+        DFA minimal(nfa);
+        minimal.minimize();
+        checkEquivalent(dfa, minimal, "ab", "random NFA seed " + std::to_string(seed));
+        check(minimal.getStateCount() <= dfa.getStateCount(), "random NFA seed " + std::to_string(seed) + ": minimization added states");
+
+        DFA twice(minimal);
+        twice.minimize();
+        check(twice.getStateCount() == minimal.getStateCount(), "random NFA seed " + std::to_string(seed) + ": minimum is not a fixed point");
+    }
+    return TestSupport::finish();
+}
\ No newline at end of file
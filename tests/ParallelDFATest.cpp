@@ -0,0 +1,82 @@
+#include <format>
+#include <random>
+#include <string>
+
+#include <DFA.h>
+#include <TestSupport.h>
+#include <ThreadPool.h>
+
+using TestSupport::check;
+
+namespace {
+    // Counts a's modulo `states`; every symbol permutes the states, so speculative candidates never converge.
+    std::string modCounter(const size_t states) {
+        std::string config = "Sigma:\na\nb\nEnd\nStates:\n";
+        for (size_t state = 0; state < states; ++state) {
+            config += std::format("m{}{}\n", state, state == 0 ? ", S, F" : "");
+        }
+        config += "End\nTransitions:\n";
+        for (size_t state = 0; state < states; ++state) {
+            config += std::format("m{}, a, m{}\nm{}, b, m{}\n", state, (state + 1) % states, state, state);
+        }
+        return config + "End\n";
+    }
+
+    // Words ending in "ab": every candidate converges within a few symbols.
+    constexpr std::string_view endsWithAb = R"(Sigma:
+a
+b
+End
+States:
+n, S
+a
+ab, F
+End
+Transitions:
+n, a, a
+n, b, n
+a, a, a
+a, b, ab
+ab, a, a
+ab, b, n
+End
+)";
+
+    std::string randomInput(std::mt19937_64& rng, const size_t length, const std::string_view alphabet) {
+        std::string input(length, 0);
+        for (auto& symbol : input) {
+            symbol = alphabet[rng() % alphabet.size()];
+        }
+        return input;
+    }
+
+    void checkAgainstSerial(const DFA& dfa, ThreadPool& pool, const std::string_view alphabet, const std::string& name) {
+        std::mt19937_64 rng(11);
+        for (size_t round = 0; round < 6; ++round) {
+            std::string input = randomInput(rng, DFA::parallelThreshold + rng() % (3 * DFA::parallelThreshold), alphabet);
+            if (round % 3 == 2) {
+                input[rng() % input.size()] = 'z';
+            }
+            check(dfa.processParallel(input, pool) == dfa.process(input), name + ": processParallel disagrees with process in round " + std::to_string(round));
+        }
+    }
+}
+
+int main() {
+    ThreadPool pool(4);
+
+    // 200 states fit the enumeration budget, so this exercises abandoning enumerated chunks that never converge.
+    const DFA counter(TestSupport::writeConfig("parallel_mod.in", modCounter(200)));
+    checkAgainstSerial(counter, pool, "ab", "mod-200 counter");
+    checkAgainstSerial(counter, pool, "b", "mod-200 counter on b only");
+
+    const DFA suffix(TestSupport::writeConfig("parallel_suffix.in", endsWithAb));
+    checkAgainstSerial(suffix, pool, "ab", "ends with ab");
+
+    // Too many states to enumerate: chunk entry states are guessed from the lookback window instead.
+    const DFA large(TestSupport::writeGenerated("parallel_large.in", {5000, 3, 3, 1.0, 0.5, 3}));
+    checkAgainstSerial(large, pool, "abc", "5000-state DFA");
+    const DFA partial(TestSupport::writeGenerated("parallel_partial.in", {5000, 3, 2, 1.0, 0.5, 5}));
+    checkAgainstSerial(partial, pool, "abc", "partial 5000-state DFA");
+    return TestSupport::finish();
+}
\ No newline at end of file
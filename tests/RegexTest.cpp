@@ -0,0 +1,40 @@
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <DFA.h>
+#include <NFA.h>
+#include <Regex.h>
+#include <TestSupport.h>
+
+using TestSupport::check;
+
+int main() {
+    // The supported syntax is a subset of ECMAScript, so std::regex serves as the reference matcher.
+    const std::vector<std::string> patterns = {
+        "a", "abc", "a|b", "a*", "a+", "a?", "(ab)*", "(a|b)*abb", "a(b|c)*a", "[a-c]+", "[ab]c?",
+        "((a|b)c)+|c", "a**", "(a?)+b", "(|a)b", "a|", "\\*a", "(a|b|c)(a|b|c)a", "((a*)|b)*c",
+    };
+    for (const auto& pattern : patterns) {
+        const NFA nfa = Regex::compile(pattern);
+        const DFA dfa(nfa);
+        const std::regex reference(pattern);
+        for (const auto& word : TestSupport::allWords("abc*", 6)) {
+            const bool expected = std::regex_match(word, reference);
+            check(nfa.process(word) == expected, "/" + pattern + "/: NFA disagrees with std::regex on \"" + word + "\"");
+            check(dfa.process(word) == expected, "/" + pattern + "/: DFA disagrees with std::regex on \"" + word + "\"");
+        }
+    }
+
+    for (const auto& invalid : {"(a", "a)", "*a", "a|*", "[a", "[]", "[c-a]", "a\\"}) {
+        bool rejected = false;
+        try {
+            Regex::compile(invalid);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        check(rejected, std::string("invalid pattern accepted: /") + invalid + "/");
+    }
+    return TestSupport::finish();
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include <string>
+
+#include <DFA.h>
+#include <StaticDFA.h>
+#include <TestSupport.h>
+
+using TestSupport::check;
+
+namespace {
+    // Binary numbers divisible by three, with a comment, a blank line and a CRLF line to exercise the parser rules.
+    constexpr char divisibleByThree[] = R"(# remainder of the value read so far
+Sigma:
+0
+1
+End
+States:
+r0, S, F
+r1
+r2
+End
+
+Transitions:
+r0, 0, r0
+r0, 1, r1
+r1, 0, r2)" "\r\n" R"(r1, 1, r0
+r2, 0, r1
+r2, 1, r2
+End
+)";
+
+    using DivisibleByThree = StaticDFA<divisibleByThree>;
+
+    static_assert(DivisibleByThree::stateCount == 3);
+    static_assert(DivisibleByThree::classCount == 3);
+    static_assert(DivisibleByThree::process(""));
+    static_assert(DivisibleByThree::process("0"));
+    static_assert(DivisibleByThree::process("11"));
+    static_assert(DivisibleByThree::process("1001"));
+    static_assert(!DivisibleByThree::process("1"));
+    static_assert(!DivisibleByThree::process("101"));
+    static_assert(!DivisibleByThree::process("12"));
+
+    // Partial: only words of the form a*b are accepted, everything else falls into the dead state.
+    using AsThenB = StaticDFA<R"(Sigma:
+a
+b
+End
+States:
+p, S
+q, F
+End
+Transitions:
+p, a, p
+p, b, q
+End
+)">;
+
+    static_assert(AsThenB::process("aaab"));
+    static_assert(AsThenB::process("b"));
+    static_assert(!AsThenB::process("ba"));
+    static_assert(!AsThenB::process("aa"));
+}
+
+int main() {
+    // The same text loaded at runtime must agree with the compile-time tables on every word.
+    const DFA dfa(TestSupport::writeConfig("static_three.in", divisibleByThree));
+    for (const auto& word : TestSupport::allWords("012", 8)) {
+        check(DivisibleByThree::process(word) == dfa.process(word), "StaticDFA and DFA disagree on \"" + word + "\"");
+    }
+    return TestSupport::finish();
+}
\ No newline at end of file
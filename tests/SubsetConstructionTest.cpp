@@ -0,0 +1,85 @@
+#include <stdexcept>
+#include <string>
+
+#include <DFA.h>
+#include <NFA.h>
+#include <TestSupport.h>
+
+using TestSupport::check;
+
+namespace {
+    // Words containing "ab", with a nondeterministic guess of where the match starts.
+    constexpr std::string_view containsAb = R"(Sigma:
+a
+b
+End
+States:
+p0, S
+p1
+p2, F
+End
+Transitions:
+p0, a, p0
+p0, b, p0
+p0, a, p1
+p1, b, p2
+p2, a, p2
+p2, b, p2
+End
+)";
+
+    // Words whose third symbol from the end is an a: the classic NFA whose DFA needs 2^3 states.
+    constexpr std::string_view thirdFromEnd = R"(Sigma:
+a
+b
+End
+States:
+s, S
+x
+y
+z, F
+End
+Transitions:
+s, a, s
+s, b, s
+s, a, x
+x, a, y
+x, b, y
+y, a, z
+y, b, z
+End
+)";
+
+    void checkEquivalent(const NFA& nfa, const DFA& dfa, const std::string_view alphabet, const std::string& name) {
+        for (const auto& word : TestSupport::allWords(alphabet, 10)) {
+            check(nfa.process(word) == dfa.process(word), name + ": DFA and NFA disagree on \"" + word + "\"");
+        }
+    }
+}
+
+int main() {
+    const NFA ab(TestSupport::writeConfig("subset_ab.in", containsAb));
+    const DFA abDfa(ab);
+    checkEquivalent(ab, abDfa, "ab", "contains ab");
+    check(abDfa.process("bbab") && !abDfa.process("bba"), "contains ab: known answers");
+
+    const NFA third(TestSupport::writeConfig("subset_third.in", thirdFromEnd));
+    const DFA thirdDfa(third);
+    checkEquivalent(third, thirdDfa, "ab", "third from end");
+    check(thirdDfa.getStateCount() == 8, "third from end: expected 8 subsets, got " + std::to_string(thirdDfa.getStateCount()));
+
+    bool limited = false;
+    try {
+        const DFA tooSmall(third, 4);
+    } catch (const std::runtime_error&) {
+        limited = true;
+    }
+    check(limited, "subset construction ignores its state limit");
+
+    for (uint64_t seed = 1; seed <= 20; ++seed) {
+        const NFA random(TestSupport::writeGenerated("subset_random.in", {12, 3, 2, 1.6, 0.4, seed}));
+        checkEquivalent(random, DFA(random), "abc", "random NFA seed " + std::to_string(seed));
+    }
+
+    return TestSupport::finish();
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Generator.h>
+
+// Shared helpers for the test executables: each test checks as much as it can, then reports through finish().
+namespace TestSupport {
+    inline int failures = 0;
+
+    inline void check(const bool condition, const std::string& what) {
+        if (!condition) {
+            ++failures;
+            std::cerr << "FAILED: " << what << std::endl;
+        }
+    }
+
+    inline int finish() {
+        if (failures) {
+            std::cerr << failures << " check(s) failed" << std::endl;
+        }
+        return failures ? 1 : 0;
+    }
+
+    inline std::filesystem::path directory() {
+        const auto path = std::filesystem::temp_directory_path() / "DFA_NFA_tests";
+        std::filesystem::create_directories(path);
+        return path;
+    }
+
+    inline std::string writeConfig(const std::string& name, const std::string_view text) {
+        const std::string path = (directory() / name).string();
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+        return path;
+    }
+
+    inline std::string writeGenerated(const std::string& name, const Generator::Parameters& parameters) {
+        const std::string path = (directory() / name).string();
+        Generator(parameters).writeConfig(path);
+        return path;
+    }
+
+    // Every word over `alphabet` of length at most `maxLength`, shortest first.
+    inline std::vector<std::string> allWords(const std::string_view alphabet, const size_t maxLength) {
+        std::vector<std::string> words = {""};
+        for (size_t i = 0; i < words.size(); ++i) {
+            if (words[i].size() == maxLength) {
+                continue;
+            }
+            for (const auto& symbol : alphabet) {
+                words.push_back(words[i] + symbol);
+            }
+        }
+        return words;
+    }
+}
\ No newline at end of file